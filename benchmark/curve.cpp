@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "curve.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	const std::size_t szValues = 1 << 20;
+
+	const std::vector<gp::Curve::Point> vPoints = {
+		{ 0.0, 0.0 },
+		{ 0.3, 0.05 },
+		{ 0.6, 0.2 },
+		{ 0.85, 0.5 },
+		{ 1.0, 1.0 }
+	};
+
+	double points(const double dValue)
+	{
+		const auto it = std::upper_bound(vPoints.begin(), vPoints.end(), dValue, [](const double dX, const gp::Curve::Point& point) {
+			return dX < point.dX;
+		});
+
+		if (it == vPoints.begin())
+		{
+			return vPoints.front().dY;
+		}
+
+		if (it == vPoints.end())
+		{
+			return vPoints.back().dY;
+		}
+
+		return (it - 1)->dY + (it->dY - (it - 1)->dY) * (dValue - (it - 1)->dX) / (it->dX - (it - 1)->dX);
+	}
+
+	template <typename F>
+	double measure(const std::vector<double>& vValues, F fCurve, double& dSum)
+	{
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		for (const double dValue : vValues)
+		{
+			dSum += fCurve(dValue);
+		}
+
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStart).count() / static_cast<double>(vValues.size());
+	}
+
+	template <typename F>
+	void run(const char* szName, F fDirect, const gp::CurvePtr& pCurve, const std::vector<double>& vValues)
+	{
+		double dSum = 0.0;
+
+		const double dDirect = measure(vValues, fDirect, dSum);
+
+		const double dTable = measure(vValues, [&curve = *pCurve](const double dValue) {
+			return curve(dValue);
+		}, dSum);
+
+		double dError = 0.0;
+
+		for (const double dValue : vValues)
+		{
+			dError = std::max(dError, std::abs((*pCurve)(dValue) - fDirect(dValue)));
+		}
+
+		std::printf("%-12s  direct %6.2f ns  table %6.2f ns  %5.2fx  max error %.2e  (%g)\n", szName, dDirect, dTable, dDirect / dTable, dError, dSum);
+	}
+}
+
+int main()
+{
+	std::vector<double> vValues(szValues);
+
+	std::uint32_t uSeed = 1;
+
+	for (double& dValue : vValues)
+	{
+		uSeed = uSeed * 1664525u + 1013904223u;
+
+		dValue = static_cast<double>(uSeed >> 8) / static_cast<double>(1u << 24);
+	}
+
+	const auto fPower = [](const double dValue) {
+		return std::pow(dValue, 2.2);
+	};
+
+	const auto fExponential = [](const double dValue) {
+		return std::expm1(3.0 * dValue) / std::expm1(3.0);
+	};
+
+	run("power", fPower, gp::makePowerCurve(2.2), vValues);
+	run("exponential", fExponential, gp::makeExponentialCurve(3.0), vValues);
+	run("points", points, gp::makePointCurve(vPoints), vValues);
+
+	return 0;
+}
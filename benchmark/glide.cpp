@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gamepad.hpp"
+#include "output.hpp"
+#include "mouse.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// A Bluetooth pad that holds its left stick fully right and reports every 8 ms with a few milliseconds of jitter.
+	class Slow : public gp::Backend
+	{
+	public:
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = gp::State();
+
+			state.sThumbLX = 32767;
+
+			return iIndex == 0;
+		}
+	};
+
+	// Remembers when every cursor move reached the sink.
+	class Timeline : public output::Sink
+	{
+	public:
+		std::vector<std::pair<std::chrono::steady_clock::time_point, int>> vMoves;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			const std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (pEvents[i].type == output::Event::Move)
+				{
+					this->vMoves.emplace_back(tNow, pEvents[i].iX);
+				}
+			}
+		}
+	};
+
+	// Cursor travel per frame of a 240 Hz display, the less it varies the smoother the motion looks.
+	void run(const int iRate)
+	{
+		std::shared_ptr<Timeline> pTimeline = std::make_shared<Timeline>();
+
+		pTimeline->vMoves.reserve(100000);
+
+		output::setSink(pTimeline);
+
+		output::glide(iRate);
+
+		gp::GamepadPtr gamepad = gp::make(0, true, std::make_shared<Slow>());
+
+		gamepad->stick(gp::Stick::Left, mouse::Motion::Move, 1000.0);
+
+		std::uint32_t uNoise = 12345;
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+		const std::chrono::steady_clock::time_point tEnd = tStart + std::chrono::seconds(2);
+
+		std::chrono::steady_clock::time_point tNext = tStart;
+
+		while (tNext < tEnd)
+		{
+			uNoise = uNoise * 1664525u + 1013904223u;
+
+			tNext += std::chrono::microseconds(5000 + (uNoise >> 16) % 6000);
+
+			std::this_thread::sleep_until(tNext);
+
+			gamepad->update();
+
+			output::commit();
+		}
+
+		output::glide(0);
+
+		const std::chrono::nanoseconds nsFrame(1000000000 / 240);
+
+		std::vector<double> vFrames;
+
+		std::size_t szMove = 0;
+
+		for (std::chrono::steady_clock::time_point tFrame = tStart + std::chrono::milliseconds(200); tFrame + nsFrame < tEnd - std::chrono::milliseconds(100); tFrame += nsFrame)
+		{
+			int iTravel = 0;
+
+			while (szMove < pTimeline->vMoves.size() && pTimeline->vMoves[szMove].first < tFrame)
+			{
+				szMove++;
+			}
+
+			for (std::size_t i = szMove; i < pTimeline->vMoves.size() && pTimeline->vMoves[i].first < tFrame + nsFrame; i++)
+			{
+				iTravel += pTimeline->vMoves[i].second;
+			}
+
+			vFrames.push_back(static_cast<double>(iTravel));
+		}
+
+		double dSum = 0.0;
+		double dSquares = 0.0;
+
+		std::size_t szStill = 0;
+
+		for (const double dTravel : vFrames)
+		{
+			dSum += dTravel;
+			dSquares += dTravel * dTravel;
+
+			szStill += dTravel == 0.0;
+		}
+
+		const double dCount = static_cast<double>(vFrames.size() ? vFrames.size() : 1);
+		const double dMean = dSum / dCount;
+
+		std::printf("%-14s  %5.2f px/frame  stddev %5.2f  still frames %5.1f%%  %6zu sink calls\n", iRate ? (std::to_string(iRate) + " Hz output").c_str() : "every update", dMean, std::sqrt(std::max(0.0, dSquares / dCount - dMean * dMean)), 100.0 * static_cast<double>(szStill) / dCount, pTimeline->vMoves.size());
+	}
+}
+
+int main()
+{
+	for (const int iRate : { 0, 240, 500, 1000 })
+	{
+		run(iRate);
+	}
+
+	return 0;
+}
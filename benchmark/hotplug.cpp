@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+#include "pads.hpp"
+#include "hotplug.hpp"
+#include "stats.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const int iSlots = 16;
+	const int iTicks = 3000;
+
+	// Devices come and go on a fixed schedule, a fake hotplug source announces them when hotplug is on.
+	class Devices : public gp::Backend
+	{
+	private:
+		gp::FakeHotplugPtr pHotplug = gp::makeFakeHotplug();
+
+		bool bHotplug;
+
+		std::vector<bool> vPresent = std::vector<bool>(iSlots, false);
+
+	public:
+		unsigned long long ullProbes = 0;
+
+		Devices(const bool bHotplug) : bHotplug(bHotplug)
+		{
+
+		}
+
+		void toggle(const int iIndex)
+		{
+			this->vPresent[iIndex] = !this->vPresent[iIndex];
+
+			const std::string sName = "event" + std::to_string(iIndex);
+
+			if (this->vPresent[iIndex])
+			{
+				this->pHotplug->add(sName);
+			}
+			else
+			{
+				this->pHotplug->remove(sName);
+			}
+		}
+
+		bool isPresent(const int iIndex) const
+		{
+			return this->vPresent[iIndex];
+		}
+
+		int count() const override
+		{
+			return iSlots;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			if (!this->vPresent[iIndex])
+			{
+				this->ullProbes++;
+
+				return false;
+			}
+
+			state = gp::State();
+
+			return true;
+		}
+
+		bool isHotplug() const override
+		{
+			return this->bHotplug;
+		}
+
+		std::size_t changes(gp::Change* pChanges, const std::size_t szCount) override
+		{
+			std::size_t szChanges = 0;
+
+			gp::Hotplug::Notification notification;
+
+			while (this->bHotplug && szChanges < szCount && this->pHotplug->next(notification))
+			{
+				const gp::Change::Type type = notification.type == gp::Hotplug::Notification::Removed ? gp::Change::Detached : gp::Change::Attached;
+
+				pChanges[szChanges++] = { type, std::stoi(notification.sName.substr(5)), notification.tSeen };
+			}
+
+			return szChanges;
+		}
+	};
+
+	void run(const bool bHotplug)
+	{
+		std::shared_ptr<Devices> pDevices = std::make_shared<Devices>(bHotplug);
+
+		gp::Pads pads;
+
+		for (int iIndex = 0; !bHotplug && iIndex < iSlots; iIndex++)
+		{
+			pads.add(gp::makeDefault(iIndex, true, pDevices));
+		}
+
+		stats::Histogram attach;
+
+		std::vector<std::chrono::steady_clock::time_point> vAppeared(iSlots);
+
+		for (int iTick = 0; iTick < iTicks; iTick++)
+		{
+			// Every 40 ms one slot gains or loses its device, a handful stay present at any time.
+			if (iTick % 40 == 0)
+			{
+				const int iIndex = iTick / 40 * 5 % iSlots;
+
+				pDevices->toggle(iIndex);
+
+				vAppeared[iIndex] = std::chrono::steady_clock::now();
+			}
+
+			gp::Change changes[16];
+
+			while (const std::size_t szChanges = pDevices->changes(changes, std::size(changes)))
+			{
+				for (std::size_t i = 0; i < szChanges; i++)
+				{
+					std::size_t szPosition = 0;
+
+					while (szPosition < pads.size() && pads[szPosition]->index() != changes[i].iIndex)
+					{
+						szPosition++;
+					}
+
+					if (changes[i].type == gp::Change::Attached && szPosition == pads.size())
+					{
+						pads.add(gp::makeDefault(changes[i].iIndex, true, pDevices));
+					}
+					else if (changes[i].type == gp::Change::Detached && szPosition < pads.size())
+					{
+						pads[szPosition]->update();
+
+						pads.remove(pads.id(szPosition));
+					}
+				}
+			}
+
+			for (std::size_t i = 0; i < pads.size(); i++)
+			{
+				const bool bConnected = pads[i]->isConnected();
+
+				pads[i]->update();
+
+				if (!bConnected && pads[i]->isConnected())
+				{
+					attach.record(std::chrono::steady_clock::now() - vAppeared[pads[i]->index()]);
+				}
+			}
+
+			output::commit();
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		std::printf("%-8s  attach p50 %8.3f  p99 %8.3f  max %8.3f ms  (%llu)  empty reads %llu\n", bHotplug ? "hotplug" : "polling",
+			std::chrono::duration<double, std::milli>(attach.percentile(50.0)).count(),
+			std::chrono::duration<double, std::milli>(attach.percentile(99.0)).count(),
+			std::chrono::duration<double, std::milli>(attach.max()).count(),
+			static_cast<unsigned long long>(attach.count()),
+			pDevices->ullProbes);
+	}
+}
+
+int main()
+{
+	output::setSink(std::make_shared<bench::Sink>());
+
+	run(false);
+
+	run(true);
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+#include "pads.hpp"
+#include "kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	const int iTicks = 20000;
+
+	void run(const int iCount)
+	{
+		std::shared_ptr<bench::Backend> pBackend = std::make_shared<bench::Backend>(iCount);
+
+		gp::Pads pads;
+
+		for (int iIndex = 0; iIndex < iCount; iIndex++)
+		{
+			pads.add(gp::makeDefault(iIndex, true, pBackend));
+		}
+
+		const double dPerPad = bench::measure(iTicks, [&] {
+			pBackend->tick();
+
+			for (std::size_t i = 0; i < pads.size(); i++)
+			{
+				pads[i]->update();
+			}
+
+			output::commit();
+		});
+
+		std::printf("%2d pads  per-pad  %10.1f ns/tick\n", iCount, dPerPad);
+
+		pads.batched(true);
+
+		const double dBatched = bench::measure(iTicks, [&] {
+			pBackend->tick();
+
+			pads.update();
+
+			output::commit();
+		});
+
+		pads.batched(false);
+
+		std::printf("%2d pads  %-7s  %10.1f ns/tick  %5.2fx\n", iCount, "batched", dBatched, dPerPad / dBatched);
+
+		pads.fixed(true);
+
+		const double dFixed = bench::measure(iTicks, [&] {
+			pBackend->tick();
+
+			pads.update();
+
+			output::commit();
+		});
+
+		pads.fixed(false);
+
+		std::printf("%2d pads  %-7s  %10.1f ns/tick  %5.2fx\n", iCount, "fixed", dFixed, dPerPad / dFixed);
+	}
+
+	// Every thumb position on a coarse grid through both stick kernels, the fixed point outputs have to stay within 0.1% of the speed.
+	bool check(const char* szName, const gp::CurvePtr& pCurve, const double dThreshold, const double dSpeed)
+	{
+		std::vector<std::int16_t> vX;
+		std::vector<std::int16_t> vY;
+
+		for (int iX = -32768; iX <= 32767; iX += 257)
+		{
+			for (int iY = -32768; iY <= 32767; iY += 263)
+			{
+				vX.push_back(static_cast<std::int16_t>(iX));
+				vY.push_back(static_cast<std::int16_t>(iY));
+			}
+		}
+
+		const std::size_t szCount = vX.size();
+
+		std::vector<double> vThreshold(szCount, dThreshold);
+		std::vector<double> vSpeed(szCount, dSpeed);
+		std::vector<double> vOutputX(szCount);
+		std::vector<double> vOutputY(szCount);
+		std::vector<double> vDeadzoned(szCount);
+
+		const double dDouble = bench::measure(20, [&] {
+			gp::kernel::deadzone(vX.data(), vY.data(), vThreshold.data(), vSpeed.data(), vOutputX.data(), vOutputY.data(), vDeadzoned.data(), szCount);
+		}) / static_cast<double>(szCount);
+
+		std::vector<std::int32_t> vFixedThreshold(szCount, static_cast<std::int32_t>(std::lround(dThreshold * (1 << gp::Curve::One))));
+		std::vector<std::int32_t> vInverse(szCount, static_cast<std::int32_t>(std::lround(65536.0 / (1.0 - dThreshold))));
+		std::vector<std::int32_t> vFixedSpeed(szCount, static_cast<std::int32_t>(std::lround(dSpeed * 65536.0)));
+		std::vector<const gp::Curve*> vCurves(szCount, pCurve.get());
+		std::vector<std::int32_t> vFixedX(szCount);
+		std::vector<std::int32_t> vFixedY(szCount);
+		std::vector<std::int32_t> vDeflection(szCount);
+
+		const double dFixed = bench::measure(20, [&] {
+			gp::kernel::deadzone(vX.data(), vY.data(), vFixedThreshold.data(), vInverse.data(), vFixedSpeed.data(), vCurves.data(), vFixedX.data(), vFixedY.data(), vDeflection.data(), szCount);
+		}) / static_cast<double>(szCount);
+
+		double dError = 0.0;
+
+		for (std::size_t i = 0; i < szCount; i++)
+		{
+			double dOutputX = vOutputX[i];
+			double dOutputY = vOutputY[i];
+
+			if (pCurve && vDeadzoned[i] > 0.0)
+			{
+				const double dDeflection = vDeadzoned[i] / (1.0 - dThreshold);
+
+				dOutputX *= (*pCurve)(dDeflection) / dDeflection;
+				dOutputY *= (*pCurve)(dDeflection) / dDeflection;
+			}
+
+			dError = std::max({ dError, std::abs(vFixedX[i] / 65536.0 - dOutputX), std::abs(vFixedY[i] / 65536.0 - dOutputY) });
+		}
+
+		const bool bMatch = dError <= dSpeed * 1e-3;
+
+		std::printf("fixed %-8s  double %5.2f ns/lane  fixed %5.2f ns/lane  max error %.4f of speed %.0f  %s\n", szName, dDouble, dFixed, dError, dSpeed, bMatch ? "ok" : "MISMATCH");
+
+		return bMatch;
+	}
+}
+
+int main()
+{
+	output::setSink(std::make_shared<bench::Sink>());
+
+	bool bMatch = true;
+
+	bMatch &= check("linear", nullptr, 0.25, 1000.0);
+	bMatch &= check("power", gp::makePowerCurve(2.2), 0.25, 1000.0);
+	bMatch &= check("bezier", gp::makeBezierCurve({ { 0.0, 0.0 }, { 0.4, 0.0 }, { 0.6, 1.0 }, { 1.0, 1.0 } }), 0.1, 10.0);
+
+	for (const int iCount : { 4, 16, 64 })
+	{
+		run(iCount);
+	}
+
+	return bMatch ? 0 : 1;
+}
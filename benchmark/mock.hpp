@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "backend.hpp"
+#include "output.hpp"
+#include "gamepad.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace bench
+{
+	// Synthetic pad states, every pad sweeps its sticks and triggers with its own phase and holds a pair of buttons now and then.
+	class Backend : public gp::Backend
+	{
+	private:
+		int iCount;
+
+		std::uint32_t uTick = 0;
+
+	public:
+		Backend(const int iCount) : iCount(iCount)
+		{
+
+		}
+
+		void tick()
+		{
+			this->uTick++;
+		}
+
+		std::uint32_t ticks() const
+		{
+			return this->uTick;
+		}
+
+		int count() const override
+		{
+			return this->iCount;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			if (iIndex >= this->iCount)
+			{
+				return false;
+			}
+
+			const std::uint32_t uPhase = this->uTick * 97 + static_cast<std::uint32_t>(iIndex) * 7919;
+
+			const std::uint32_t uWindow = this->uTick / 64 + static_cast<std::uint32_t>(iIndex);
+
+			state.wButtons = uWindow % 4 == 0 ? static_cast<std::uint16_t>((1u << (uWindow * 5 % gp::Button::Count)) | (1u << (uWindow * 11 % gp::Button::Count))) : 0;
+
+			state.bLeftTrigger = static_cast<std::uint8_t>(uPhase);
+			state.bRightTrigger = static_cast<std::uint8_t>(uPhase >> 3);
+
+			state.sThumbLX = static_cast<std::int16_t>(uPhase * 13);
+			state.sThumbLY = static_cast<std::int16_t>(uPhase * 29);
+			state.sThumbRX = static_cast<std::int16_t>(uPhase * 31);
+			state.sThumbRY = static_cast<std::int16_t>(uPhase * 37);
+
+			return true;
+		}
+	};
+
+	class Sink : public output::Sink
+	{
+	public:
+		unsigned long long ullEvents = 0;
+
+		void commit(const output::Event*, const std::size_t szCount) override
+		{
+			this->ullEvents += szCount;
+		}
+	};
+
+	template <typename F>
+	double measure(const int iTicks, F fTick)
+	{
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iTicks; i++)
+		{
+			fTick();
+		}
+
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStart).count() / iTicks;
+	}
+}
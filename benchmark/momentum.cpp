@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gamepad.hpp"
+#include "output.hpp"
+#include "mouse.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+	// The right stick is flicked up for 60 ms and released, in the second run it is pushed down briefly 300 ms later.
+	class Clock : public gp::Backend
+	{
+	private:
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		std::chrono::nanoseconds nsTime = std::chrono::nanoseconds::zero();
+
+	public:
+		bool bCounter = false;
+
+		void advance(const std::chrono::nanoseconds nsStep)
+		{
+			this->nsTime += nsStep;
+		}
+
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = gp::State();
+
+			if (this->nsTime < std::chrono::milliseconds(60))
+			{
+				state.sThumbRY = 32767;
+			}
+			else if (this->bCounter && this->nsTime >= std::chrono::milliseconds(300) && this->nsTime < std::chrono::milliseconds(320))
+			{
+				state.sThumbRY = -9000;
+			}
+
+			return iIndex == 0;
+		}
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return this->tStart + this->nsTime;
+		}
+	};
+
+	class Wheel : public output::Sink
+	{
+	public:
+		long long llY = 0;
+		long long llPush = 0;
+
+		std::chrono::nanoseconds nsLast = std::chrono::nanoseconds::zero();
+
+		std::chrono::nanoseconds nsNow = std::chrono::nanoseconds::zero();
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (pEvents[i].type == output::Event::Scroll && pEvents[i].iY != 0)
+				{
+					this->llY += pEvents[i].iY;
+
+					if (this->nsNow < std::chrono::milliseconds(300))
+					{
+						this->llPush = this->llY;
+					}
+
+					this->nsLast = this->nsNow;
+				}
+			}
+		}
+	};
+
+	void run(const int iRate, const bool bCounter)
+	{
+		std::shared_ptr<Wheel> pWheel = std::make_shared<Wheel>();
+
+		output::setSink(pWheel);
+
+		std::shared_ptr<Clock> pClock = std::make_shared<Clock>();
+
+		pClock->bCounter = bCounter;
+
+		gp::GamepadPtr gamepad = gp::make(0, true, pClock);
+
+		gamepad->stick(gp::Stick::Right, mouse::Motion::Scroll, 2400.0, 0.25, nullptr, gp::Smoothing(), { 3.0, 20.0 });
+
+		const std::chrono::nanoseconds nsStep = std::chrono::nanoseconds(1000000000 / iRate);
+
+		for (int iTick = 0; iTick <= 4 * iRate; iTick++)
+		{
+			pWheel->nsNow = nsStep * iTick;
+
+			gamepad->update();
+
+			output::commit();
+
+			pClock->advance(nsStep);
+		}
+
+		std::printf("%4d Hz  %-8s  wheel %6lld at 300 ms  %6lld at the end  last scroll at %6.1f ms\n", iRate, bCounter ? "stopped" : "coasting", pWheel->llPush, pWheel->llY, std::chrono::duration<double, std::milli>(pWheel->nsLast).count());
+	}
+}
+
+// A flick scrolls the same distance for the same time at every poll rate, and a push against it stops it at once.
+int main()
+{
+	for (const bool bCounter : { false, true })
+	{
+		for (const int iRate : { 125, 250, 500, 1000 })
+		{
+			run(iRate, bCounter);
+		}
+	}
+
+	return 0;
+}
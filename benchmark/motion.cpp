@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+	// The left stick holds a new deflection every 250 ms, timed by a virtual clock so every poll rate sees the same motion.
+	class Clock : public gp::Backend
+	{
+	private:
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		std::chrono::nanoseconds nsTime = std::chrono::nanoseconds::zero();
+
+	public:
+		void advance(const std::chrono::nanoseconds nsStep)
+		{
+			this->nsTime += nsStep;
+		}
+
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int, gp::State& state) override
+		{
+			static const std::int16_t sDeflections[][2] = {
+				{ 32767, 0 },
+				{ 16000, -24000 },
+				{ -9000, 30000 },
+				{ 0, 0 },
+				{ -32768, -32768 },
+				{ 12000, 12000 },
+				{ 20000, -5000 },
+				{ -27000, 8000 }
+			};
+
+			const std::size_t szSegment = static_cast<std::size_t>(this->nsTime / std::chrono::milliseconds(250)) % std::size(sDeflections);
+
+			state = gp::State();
+
+			state.sThumbLX = sDeflections[szSegment][0];
+			state.sThumbLY = sDeflections[szSegment][1];
+
+			return true;
+		}
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return this->tStart + this->nsTime;
+		}
+	};
+
+	class Cursor : public output::Sink
+	{
+	public:
+		long long llX = 0;
+		long long llY = 0;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (pEvents[i].type == output::Event::Move)
+				{
+					this->llX += pEvents[i].iX;
+					this->llY += pEvents[i].iY;
+				}
+			}
+		}
+	};
+
+	void run(const int iRate, const bool bPerTick)
+	{
+		std::shared_ptr<Cursor> pCursor = std::make_shared<Cursor>();
+
+		output::setSink(pCursor);
+
+		mouse::reset();
+
+		std::shared_ptr<Clock> pClock = std::make_shared<Clock>();
+
+		gp::GamepadPtr gamepad = gp::make(0, true, pClock);
+
+		if (bPerTick)
+		{
+			gamepad->stick(gp::Stick::Left, mouse::move, 10.0);
+		}
+		else
+		{
+			gamepad->stick(gp::Stick::Left, mouse::Motion::Move, 1000.0);
+		}
+
+		const std::chrono::nanoseconds nsStep = std::chrono::nanoseconds(1000000000 / iRate);
+
+		for (int iTick = 0; iTick <= 4 * iRate; iTick++)
+		{
+			gamepad->update();
+
+			output::commit();
+
+			pClock->advance(nsStep);
+		}
+
+		std::printf("%4d Hz  %-10s  cursor %7lld %7lld\n", iRate, bPerTick ? "per tick" : "per second", pCursor->llX, pCursor->llY);
+	}
+}
+
+int main()
+{
+	for (const bool bPerTick : { true, false })
+	{
+		for (const int iRate : { 100, 200, 250, 500, 1000 })
+		{
+			run(iRate, bPerTick);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+std::atomic<unsigned long long> ullAllocations = 0;
+
+void* operator new(const std::size_t szSize)
+{
+	ullAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* pMemory = std::malloc(szSize ? szSize : 1))
+	{
+		return pMemory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+namespace
+{
+	const int iTicks = 20000;
+
+	unsigned long long ullCallbacks = 0;
+
+	typedef std::function<gp::GamepadPtr(const int iIndex, const gp::BackendPtr& pBackend)> Profile;
+
+	gp::GamepadPtr profileDefault(const int iIndex, const gp::BackendPtr& pBackend)
+	{
+		return gp::makeDefault(iIndex, true, pBackend);
+	}
+
+	gp::GamepadPtr profileBindings(const int iIndex, const gp::BackendPtr& pBackend)
+	{
+		gp::GamepadPtr gamepad = gp::make(iIndex, true, pBackend);
+
+		for (unsigned int uButton = 0; uButton < gp::Button::Count; uButton++)
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				gamepad->button(static_cast<gp::Button::Name>(uButton), [] { ullCallbacks++; }, [] { ullCallbacks++; });
+			}
+		}
+
+		for (unsigned int uAxis = 0; uAxis < gp::Axis::Count; uAxis++)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				gamepad->axis(static_cast<gp::Axis::Name>(uAxis), [](const double) { ullCallbacks++; });
+				gamepad->axisButton(static_cast<gp::Axis::Name>(uAxis), [] { ullCallbacks++; }, [] { ullCallbacks++; });
+			}
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			gamepad->stick(gp::Stick::Left, [](const double, const double) { ullCallbacks++; });
+			gamepad->stick(gp::Stick::Right, [](const double, const double) { ullCallbacks++; });
+		}
+
+		return gamepad;
+	}
+
+	gp::GamepadPtr profileCombinations(const int iIndex, const gp::BackendPtr& pBackend)
+	{
+		gp::GamepadPtr gamepad = gp::make(iIndex, true, pBackend);
+
+		for (unsigned int uFirst = 0; uFirst < gp::Button::Count; uFirst++)
+		{
+			for (unsigned int uSecond = uFirst + 1; uSecond < gp::Button::Count; uSecond++)
+			{
+				gamepad->combination(static_cast<gp::Button::Name>(uFirst), static_cast<gp::Button::Name>(uSecond), [] { ullCallbacks++; }, [] { ullCallbacks++; });
+			}
+
+			gamepad->combination(static_cast<gp::Button::Name>(uFirst), gp::Axis::TriggerLeft, [] { ullCallbacks++; }, [] { ullCallbacks++; });
+			gamepad->combination(static_cast<gp::Button::Name>(uFirst), gp::Axis::TriggerRight, 0.75, [] { ullCallbacks++; }, [] { ullCallbacks++; });
+		}
+
+		return gamepad;
+	}
+
+	void run(const char* szName, const Profile& fProfile, const int iCount)
+	{
+		std::shared_ptr<bench::Backend> pBackend = std::make_shared<bench::Backend>(iCount);
+
+		std::vector<gp::GamepadPtr> vGamepads;
+
+		for (int iIndex = 0; iIndex < iCount; iIndex++)
+		{
+			vGamepads.push_back(fProfile(iIndex, pBackend));
+		}
+
+		const auto fTick = [&] {
+			pBackend->tick();
+
+			for (const gp::GamepadPtr& gamepad : vGamepads)
+			{
+				gamepad->update();
+			}
+
+			output::commit();
+		};
+
+		// One warm-up pass so lazily grown buffers reach their steady-state size.
+		bench::measure(iTicks / 10, fTick);
+
+		const unsigned long long ullAllocationsStart = ullAllocations;
+		const unsigned long long ullCallbacksStart = ullCallbacks;
+		const unsigned long long ullQueuedStart = output::statistics().ullQueued;
+
+		const double dTick = bench::measure(iTicks, fTick);
+
+		// Built-in actions only show up as queued output events, so those count as callbacks as well.
+		const double dCallbacks = static_cast<double>(ullCallbacks - ullCallbacksStart + output::statistics().ullQueued - ullQueuedStart);
+		const double dAllocations = static_cast<double>(ullAllocations - ullAllocationsStart);
+
+		std::printf("%-12s %3d pads  %10.1f ns/tick  %8.3f allocs/tick  %12.0f callbacks/s\n", szName, iCount, dTick, dAllocations / iTicks, dCallbacks / (dTick * iTicks) * 1e9);
+	}
+}
+
+int main()
+{
+	output::setSink(std::make_shared<bench::Sink>());
+
+	const struct
+	{
+		const char* szName;
+		Profile fProfile;
+	} scenarios[] = {
+		{ "default", profileDefault },
+		{ "bindings", profileBindings },
+		{ "combinations", profileCombinations }
+	};
+
+	for (const auto& scenario : scenarios)
+	{
+		for (const int iCount : { 1, 4, 16, 64 })
+		{
+			run(scenario.szName, scenario.fProfile, iCount);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+#include "pads.hpp"
+#include "prober.hpp"
+#include "stats.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+	const int iTicks = 3000;
+
+	// XInput takes its time to report an empty slot, here every probe of one busy waits for a millisecond.
+	class SlowProbes : public bench::Backend
+	{
+	public:
+		unsigned long long ullProbes = 0;
+
+		SlowProbes() : bench::Backend(4)
+		{
+
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			if (iIndex == 0)
+			{
+				return bench::Backend::read(iIndex, state);
+			}
+
+			this->ullProbes++;
+
+			const std::chrono::steady_clock::time_point tEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+
+			while (std::chrono::steady_clock::now() < tEnd)
+			{
+
+			}
+
+			return false;
+		}
+	};
+
+	void run(const bool bStagger)
+	{
+		std::shared_ptr<SlowProbes> pSlow = std::make_shared<SlowProbes>();
+
+		gp::BackendPtr pBackend = pSlow;
+
+		if (bStagger)
+		{
+			pBackend = gp::makeProber(pSlow);
+		}
+
+		gp::Pads pads;
+
+		for (int iIndex = 0; iIndex < pSlow->count(); iIndex++)
+		{
+			pads.add(gp::makeDefault(iIndex, true, pBackend));
+		}
+
+		stats::Histogram ticks;
+
+		for (int iTick = 0; iTick < iTicks; iTick++)
+		{
+			pBackend->wait(1);
+
+			const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+			pSlow->tick();
+
+			pads.update();
+
+			output::commit();
+
+			ticks.record(std::chrono::steady_clock::now() - tStart);
+		}
+
+		std::printf("%-9s  tick p50 %7.3f  p99 %7.3f  p99.9 %7.3f  max %7.3f ms  probes %llu\n", bStagger ? "staggered" : "lockstep",
+			std::chrono::duration<double, std::milli>(ticks.percentile(50.0)).count(),
+			std::chrono::duration<double, std::milli>(ticks.percentile(99.0)).count(),
+			std::chrono::duration<double, std::milli>(ticks.percentile(99.9)).count(),
+			std::chrono::duration<double, std::milli>(ticks.max()).count(),
+			pSlow->ullProbes);
+	}
+}
+
+int main()
+{
+	output::setSink(std::make_shared<bench::Sink>());
+
+	run(false);
+
+	run(true);
+
+	return 0;
+}
@@ -0,0 +1,377 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gamepad.hpp"
+#include "output.hpp"
+#include "profile.hpp"
+#include "stats.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// The built-in layout written as a profile.
+	const char* const szDefault =
+		"# gamepad-mouse defaults\n"
+		"button A mouse Left\n"
+		"button B mouse Right\n"
+		"button X key Return\n"
+		"button Y call OnScreenKeyboard\n"
+		"button DpadUp key Up\n"
+		"button DpadDown key Down\n"
+		"button DpadLeft key Left\n"
+		"button DpadRight key Right\n"
+		"button ThumbLeft mouse Middle\n"
+		"button ThumbRight key Control\n"
+		"button ShoulderLeft call SwitchWindows\n"
+		"button ShoulderRight call TakeScreenshot\n"
+		"axis TriggerLeft motion ScrollY 1000\n"
+		"axis TriggerRight motion ScrollY -1000\n"
+		"stick Left motion Move 1000\n"
+		"stick Right motion Scroll 1000\n"
+		"always combination Back Start event Toggle\n";
+
+	const char* const szTuned =
+		"button A mouse Left\n"
+		"button B mouse Right\n"
+		"axisbutton TriggerRight mouse Left press 0.6 release 0.3\n"
+		"stick Left motion Move 1400 threshold 0.2 curve power 2 smoothing 1 0.01 inertia 4\n"
+		"stick Right motion Scroll 800 curve exponential 3\n"
+		"combination ShoulderLeft ShoulderRight key Escape\n";
+
+	// Presses a pseudo random set of buttons every few ticks and sweeps the axes, the buttons that call into the desktop stay untouched.
+	class Script : public gp::Backend
+	{
+	private:
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		std::chrono::nanoseconds nsTime = std::chrono::nanoseconds::zero();
+
+		std::uint32_t uSeed = 1;
+
+		gp::State state;
+
+		int iTick = 0;
+
+	public:
+		void advance(const std::chrono::nanoseconds nsStep)
+		{
+			this->nsTime += nsStep;
+
+			if (this->iTick++ % 7 == 0)
+			{
+				this->uSeed = this->uSeed * 1664525u + 1013904223u;
+
+				const std::uint16_t wCalls = (1u << gp::Button::Y) | (1u << gp::Button::ShoulderLeft) | (1u << gp::Button::ShoulderRight);
+
+				this->state.wButtons = static_cast<std::uint16_t>(this->uSeed >> 16) & ~wCalls;
+
+				this->state.bLeftTrigger = static_cast<std::uint8_t>(this->uSeed >> 8);
+				this->state.bRightTrigger = static_cast<std::uint8_t>(this->uSeed >> 4);
+
+				this->state.sThumbLX = static_cast<std::int16_t>(this->uSeed);
+				this->state.sThumbLY = static_cast<std::int16_t>(this->uSeed >> 3);
+				this->state.sThumbRX = static_cast<std::int16_t>(this->uSeed >> 5);
+				this->state.sThumbRY = static_cast<std::int16_t>(this->uSeed >> 7);
+			}
+		}
+
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = this->state;
+
+			return iIndex == 0;
+		}
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return this->tStart + this->nsTime;
+		}
+	};
+
+	class Hash : public output::Sink
+	{
+	public:
+		std::uint64_t ullHash = 14695981039346656037ull;
+
+		unsigned long long ullEvents = 0;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				for (const std::uint64_t ullValue : { static_cast<std::uint64_t>(pEvents[i].type), static_cast<std::uint64_t>(pEvents[i].uCode), static_cast<std::uint64_t>(static_cast<std::uint32_t>(pEvents[i].iX)), static_cast<std::uint64_t>(static_cast<std::uint32_t>(pEvents[i].iY)) })
+				{
+					this->ullHash = (this->ullHash ^ ullValue) * 1099511628211ull;
+				}
+			}
+
+			this->ullEvents += szCount;
+		}
+	};
+
+	Hash run(const gp::GamepadPtr& gamepad, const std::shared_ptr<Script>& pScript)
+	{
+		std::shared_ptr<Hash> pHash = std::make_shared<Hash>();
+
+		output::setSink(pHash);
+
+		for (int iTick = 0; iTick < 20000; iTick++)
+		{
+			gamepad->update();
+
+			output::commit();
+
+			pScript->advance(std::chrono::milliseconds(1));
+		}
+
+		output::setSink(nullptr);
+
+		return *pHash;
+	}
+
+	void print(const char* szName, const stats::Histogram& histogram)
+	{
+		std::printf("%-8s p50 %8.3f  p99 %8.3f  max %8.3f us  (%llu)\n", szName,
+			std::chrono::duration<double, std::micro>(histogram.percentile(50.0)).count(),
+			std::chrono::duration<double, std::micro>(histogram.percentile(99.0)).count(),
+			std::chrono::duration<double, std::micro>(histogram.max()).count(),
+			static_cast<unsigned long long>(histogram.count()));
+	}
+}
+
+// Checks that the default profile drives the pads exactly like the built-in layout, then times compiling and loading from the cache,
+// swapping a profile into 16 pads, loading a large one with and without its cache and picking up an edited file.
+int main()
+{
+	std::string sError;
+
+	gp::profile::ProfilePtr pDefault = gp::profile::compile(szDefault, sError);
+	gp::profile::ProfilePtr pTuned = gp::profile::compile(szTuned, sError);
+
+	if (!pDefault || !pTuned)
+	{
+		std::printf("%s\n", sError.c_str());
+
+		return 1;
+	}
+
+	std::shared_ptr<Script> pBuiltIn = std::make_shared<Script>();
+
+	const Hash builtIn = run(gp::makeDefault(0, true, pBuiltIn), pBuiltIn);
+
+	std::shared_ptr<Script> pProfiled = std::make_shared<Script>();
+
+	gp::GamepadPtr profiled = gp::make(0, true, pProfiled);
+
+	profiled->adopt(pDefault->bindings());
+
+	const Hash fromProfile = run(profiled, pProfiled);
+
+	std::printf("built-in %016llx  profile %016llx  %llu events  %s\n", static_cast<unsigned long long>(builtIn.ullHash), static_cast<unsigned long long>(fromProfile.ullHash), fromProfile.ullEvents, builtIn.ullHash == fromProfile.ullHash && builtIn.ullEvents == fromProfile.ullEvents ? "match" : "MISMATCH");
+
+	for (const char* szBroken : { "button A mouse Lefty\n", "stick Left motion Move fast\n", "combination key Escape\n" })
+	{
+		gp::profile::compile(std::string("button B mouse Right\n") + szBroken, sError);
+
+		std::printf("error    %s\n", sError.c_str());
+	}
+
+	stats::Histogram compileHistogram;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		gp::profile::compile(szDefault, sError);
+
+		compileHistogram.record(std::chrono::steady_clock::now() - tStart);
+	}
+
+	// The same profile read back from its cache, which skips the text and the parser.
+	std::ofstream("benchmark.profile", std::ios::binary) << szDefault;
+
+	gp::profile::load("benchmark.profile", sError);
+
+	stats::Histogram loadHistogram;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		gp::profile::load("benchmark.profile", sError);
+
+		loadHistogram.record(std::chrono::steady_clock::now() - tStart);
+	}
+
+	std::vector<gp::GamepadPtr> vGamepads;
+
+	for (int i = 0; i < 16; i++)
+	{
+		vGamepads.push_back(gp::make(i, true, std::make_shared<Script>()));
+	}
+
+	stats::Histogram swapHistogram;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		const gp::Gamepad& layout = (i % 2 ? pTuned : pDefault)->bindings();
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		for (const gp::GamepadPtr& gamepad : vGamepads)
+		{
+			gamepad->adopt(layout);
+		}
+
+		swapHistogram.record(std::chrono::steady_clock::now() - tStart);
+	}
+
+	print("compile", compileHistogram);
+	print("load", loadHistogram);
+	print("swap 16", swapHistogram);
+
+	// A large profile read from disk: parsed on every start versus mapped from the cache, and a cache with a flipped byte.
+	std::string sLarge;
+
+	for (int i = 0; i < 256; i++)
+	{
+		sLarge += std::string(szDefault) + szTuned;
+	}
+
+	std::ofstream("large.profile", std::ios::binary) << sLarge;
+
+	std::remove("large.profile.cache");
+
+	stats::Histogram parsedHistogram;
+	stats::Histogram cachedHistogram;
+
+	bool bCached = false;
+
+	for (int i = 0; i < 200; i++)
+	{
+		gp::profile::compile(sLarge, sError);
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		gp::profile::ProfilePtr pLarge = gp::profile::load("large.profile", sError, &bCached);
+
+		(bCached ? cachedHistogram : parsedHistogram).record(std::chrono::steady_clock::now() - tStart);
+
+		if (i % 50 == 49)
+		{
+			std::remove("large.profile.cache");
+		}
+	}
+
+	{
+		std::fstream cache("large.profile.cache", std::ios::binary | std::ios::in | std::ios::out);
+
+		cache.seekp(static_cast<std::streamoff>(sizeof(gp::profile::Header) + 12));
+		cache.put('\x7f');
+	}
+
+	const std::size_t szLarge = gp::profile::load("large.profile", sError, &bCached)->size();
+
+	std::printf("large    %zu entries, corrupted cache %s\n", szLarge, bCached ? "USED" : "rejected");
+
+	print("parsed", parsedHistogram);
+	print("cached", cachedHistogram);
+
+	// Time to a first tick of 16 pads, built one by one from the layout code or from the cached default profile.
+	std::ofstream("benchmark.profile", std::ios::binary) << szDefault;
+
+	gp::profile::load("benchmark.profile", sError);
+
+	stats::Histogram builtHistogram;
+	stats::Histogram adoptedHistogram;
+
+	for (int i = 0; i < 200; i++)
+	{
+		const bool bAdopt = i % 2;
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		gp::profile::ProfilePtr pProfile = bAdopt ? gp::profile::load("benchmark.profile", sError) : nullptr;
+
+		std::shared_ptr<Script> pScript = std::make_shared<Script>();
+
+		std::vector<gp::GamepadPtr> vPads;
+
+		for (int iPad = 0; iPad < 16; iPad++)
+		{
+			if (bAdopt)
+			{
+				vPads.push_back(gp::make(iPad, true, pScript));
+
+				vPads.back()->adopt(pProfile->bindings());
+			}
+			else
+			{
+				vPads.push_back(gp::makeDefault(iPad, true, pScript));
+			}
+
+			vPads.back()->update();
+		}
+
+		(bAdopt ? adoptedHistogram : builtHistogram).record(std::chrono::steady_clock::now() - tStart);
+	}
+
+	print("built 16", builtHistogram);
+	print("cache 16", adoptedHistogram);
+
+	gp::profile::WatcherPtr pWatcher = gp::profile::makeWatcher("benchmark.profile", std::chrono::milliseconds(10));
+
+	const gp::profile::Profile* pFirst = pWatcher->acquire();
+
+	const std::chrono::steady_clock::time_point tEdited = std::chrono::steady_clock::now();
+
+	std::ofstream("benchmark.profile") << szTuned;
+
+	const gp::profile::Profile* pLatest = pFirst;
+
+	while (pLatest == pFirst && std::chrono::steady_clock::now() - tEdited < std::chrono::seconds(2))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		pLatest = pWatcher->acquire();
+	}
+
+	std::printf("reload   %.1f ms after the edit, %zu entries, %llu loads\n", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tEdited).count(), pLatest->size(), pWatcher->statistics().ullLoads);
+
+	print("watched", pWatcher->load());
+
+	return 0;
+}
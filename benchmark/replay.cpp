@@ -0,0 +1,360 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mock.hpp"
+
+#include "gamepad.hpp"
+#include "trace.hpp"
+#include "mouse.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::chrono::milliseconds msStep(1);
+
+	// Mock states on a virtual millisecond clock, so the generated trace is the same on every machine.
+	class Clocked : public bench::Backend
+	{
+	public:
+		using bench::Backend::Backend;
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return std::chrono::steady_clock::time_point(msStep * this->ticks());
+		}
+	};
+
+	class Hash : public output::Sink
+	{
+	public:
+		unsigned long long ullHash = 1469598103934665603ull;
+		unsigned long long ullEvents = 0;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				for (const unsigned long long ullValue : { static_cast<unsigned long long>(pEvents[i].type), static_cast<unsigned long long>(pEvents[i].uCode), static_cast<unsigned long long>(pEvents[i].iX), static_cast<unsigned long long>(pEvents[i].iY) })
+				{
+					this->ullHash = (this->ullHash ^ ullValue) * 1099511628211ull;
+				}
+			}
+
+			this->ullEvents += szCount;
+		}
+	};
+
+	// A worn left stick: it rests at a third of its travel with noise on both axes and jumps to full deflection every other 250 ms.
+	class Worn : public gp::Backend
+	{
+	private:
+		std::uint32_t uTick = 0;
+		std::uint32_t uNoise = 12345;
+
+		std::int16_t noise()
+		{
+			this->uNoise = this->uNoise * 1664525u + 1013904223u;
+
+			return static_cast<std::int16_t>(static_cast<int>(this->uNoise >> 22) - 512);
+		}
+
+	public:
+		static constexpr std::uint32_t uSegment = 250;
+
+		static constexpr std::int16_t sHold = 11500;
+
+		void tick()
+		{
+			this->uTick++;
+		}
+
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = gp::State();
+
+			state.sThumbLX = static_cast<std::int16_t>((this->uTick / uSegment) % 2 ? 32767 : sHold + this->noise());
+			state.sThumbLY = this->noise();
+
+			return iIndex == 0;
+		}
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return std::chrono::steady_clock::time_point(msStep * this->uTick);
+		}
+	};
+
+	void generate(const std::string& sPath, const int iCount, const int iTicks)
+	{
+		std::shared_ptr<Clocked> pClocked = std::make_shared<Clocked>(iCount);
+
+		const gp::BackendPtr pRecorder = gp::trace::makeRecorder(pClocked, sPath);
+
+		for (int i = 0; i < iTicks; i++)
+		{
+			pClocked->tick();
+
+			for (int iIndex = 0; iIndex < iCount; iIndex++)
+			{
+				gp::State state;
+
+				pRecorder->read(iIndex, state);
+			}
+
+			// The recorder drains in the background at its own pace, a real poll loop is never this fast.
+			if (i % 500 == 0)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(60));
+			}
+		}
+	}
+
+	bool replay(const std::string& sPath, const std::shared_ptr<Hash>& pHash)
+	{
+		const gp::trace::ReplayPtr pReplay = gp::trace::makeReplay(sPath);
+
+		if (!pReplay)
+		{
+			std::fprintf(stderr, "cannot open trace %s\n", sPath.c_str());
+
+			return false;
+		}
+
+		mouse::reset();
+
+		std::vector<gp::GamepadPtr> vGamepads;
+
+		for (int iIndex = 0; iIndex < pReplay->count(); iIndex++)
+		{
+			vGamepads.push_back(gp::makeDefault(iIndex, true, pReplay));
+		}
+
+		unsigned long long ullTicks = 0;
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		while (pReplay->advance(msStep))
+		{
+			for (const gp::GamepadPtr& gamepad : vGamepads)
+			{
+				gamepad->update();
+			}
+
+			output::commit();
+
+			ullTicks++;
+		}
+
+		const double dElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStart).count();
+
+		std::printf("%d pads  %llu ticks  %.3f s virtual  %10.1f ns/tick  %llu events  hash %016llx\n", pReplay->count(), ullTicks, std::chrono::duration<double>(pReplay->time()).count(), dElapsed / static_cast<double>(ullTicks ? ullTicks : 1), pHash->ullEvents, pHash->ullHash);
+
+		return true;
+	}
+
+	void generateWorn(const std::string& sPath, const int iTicks)
+	{
+		std::shared_ptr<Worn> pWorn = std::make_shared<Worn>();
+
+		const gp::BackendPtr pRecorder = gp::trace::makeRecorder(pWorn, sPath);
+
+		for (int i = 0; i < iTicks; i++)
+		{
+			pWorn->tick();
+
+			gp::State state;
+
+			pRecorder->read(0, state);
+
+			if (i % 500 == 0)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(60));
+			}
+		}
+	}
+
+	// Stick outputs per tick of the worn trace, with or without smoothing.
+	bool outputs(const std::string& sPath, const gp::Smoothing& smoothing, std::vector<double>& vX, std::vector<double>& vY)
+	{
+		const gp::trace::ReplayPtr pReplay = gp::trace::makeReplay(sPath);
+
+		if (!pReplay)
+		{
+			std::fprintf(stderr, "cannot open trace %s\n", sPath.c_str());
+
+			return false;
+		}
+
+		double dX = 0.0;
+		double dY = 0.0;
+
+		const gp::GamepadPtr gamepad = gp::make(0, true, pReplay);
+
+		gamepad->stick(gp::Stick::Left, [&dX, &dY](const double dOutputX, const double dOutputY)
+		{
+			dX = dOutputX;
+			dY = dOutputY;
+		}, 1.0, 0.25, nullptr, smoothing);
+
+		while (pReplay->advance(msStep))
+		{
+			dX = 0.0;
+			dY = 0.0;
+
+			gamepad->update();
+
+			vX.push_back(dX);
+			vY.push_back(dY);
+		}
+
+		return true;
+	}
+
+	// The lag of a step is the area between the plain and the smoothed output divided by the height of the step.
+	bool smoothing(const std::string& sPath)
+	{
+		const gp::Smoothing smoothings[] = {
+			{ 1.0, 2.0, 1.0 },
+			{ 2.0, 10.0, 1.0 },
+			{ 5.0, 20.0, 1.0 }
+		};
+
+		std::vector<double> vPlainX;
+		std::vector<double> vPlainY;
+
+		if (!outputs(sPath, gp::Smoothing(), vPlainX, vPlainY))
+		{
+			return false;
+		}
+
+		for (const gp::Smoothing& smoothing : smoothings)
+		{
+			std::vector<double> vX;
+			std::vector<double> vY;
+
+			if (!outputs(sPath, smoothing, vX, vY) || vX.size() != vPlainX.size())
+			{
+				return false;
+			}
+
+			double dArea = 0.0;
+			double dHeight = 0.0;
+
+			double dPlainSquares = 0.0;
+			double dSquares = 0.0;
+
+			std::size_t szSteps = 0;
+			std::size_t szHolds = 0;
+
+			for (std::size_t i = 0; i < vX.size(); i++)
+			{
+				const std::size_t szTick = i + 1;
+
+				const bool bFull = (szTick / Worn::uSegment) % 2 != 0;
+
+				if (bFull)
+				{
+					dArea += vPlainX[i] - vX[i];
+				}
+				else if (szTick % Worn::uSegment >= Worn::uSegment / 2)
+				{
+					dPlainSquares += vPlainY[i] * vPlainY[i];
+					dSquares += vY[i] * vY[i];
+
+					szHolds++;
+				}
+
+				if (bFull && szTick % Worn::uSegment == 0)
+				{
+					dHeight += vPlainX[i] - vPlainX[i - 1];
+
+					szSteps++;
+				}
+			}
+
+			const double dLag = szSteps && dHeight > 0.0 ? dArea / dHeight * std::chrono::duration<double, std::milli>(msStep).count() : 0.0;
+
+			std::printf("smoothing %4.1f Hz  beta %5.1f  added latency %6.2f ms per step  jitter %.4f -> %.4f\n", smoothing.dMinimumCutoff, smoothing.dBeta, dLag, std::sqrt(dPlainSquares / static_cast<double>(szHolds ? szHolds : 1)), std::sqrt(dSquares / static_cast<double>(szHolds ? szHolds : 1)));
+		}
+
+		return true;
+	}
+}
+
+// Replays a trace recorded by the application (gamepad-mouse.exe <trace>) twice, without arguments a synthetic trace is generated first.
+int main(int argc, char** argv)
+{
+	std::string sPath = argc > 1 ? argv[1] : "synthetic.trace";
+
+	if (argc <= 1)
+	{
+		generate(sPath, 4, 20000);
+	}
+
+	unsigned long long ullHashes[2] = {};
+
+	for (unsigned long long& ullHash : ullHashes)
+	{
+		std::shared_ptr<Hash> pHash = std::make_shared<Hash>();
+
+		output::setSink(pHash);
+
+		if (!replay(sPath, pHash))
+		{
+			return 1;
+		}
+
+		ullHash = pHash->ullHash;
+	}
+
+	if (ullHashes[0] != ullHashes[1])
+	{
+		std::fprintf(stderr, "replays diverged\n");
+
+		return 1;
+	}
+
+	if (argc <= 1)
+	{
+		generateWorn("worn.trace", 10000);
+
+		if (!smoothing("worn.trace"))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gamepad.hpp"
+#include "output.hpp"
+#include "mouse.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+	// Both triggers half pulled and both sticks pushed diagonally, so every default binding that scrolls or moves fires on every tick.
+	class Clock : public gp::Backend
+	{
+	private:
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		std::chrono::nanoseconds nsTime = std::chrono::nanoseconds::zero();
+
+	public:
+		void advance(const std::chrono::nanoseconds nsStep)
+		{
+			this->nsTime += nsStep;
+		}
+
+		int count() const override
+		{
+			return 1;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = gp::State();
+
+			state.bLeftTrigger = 200;
+			state.bRightTrigger = 100;
+
+			state.sThumbLX = 20000;
+			state.sThumbLY = -20000;
+			state.sThumbRX = -16000;
+			state.sThumbRY = 24000;
+
+			return iIndex == 0;
+		}
+
+		std::chrono::steady_clock::time_point now() const override
+		{
+			return this->tStart + this->nsTime;
+		}
+	};
+
+	class Wheel : public output::Sink
+	{
+	public:
+		unsigned long long ullEvents = 0;
+		unsigned long long ullScrolls = 0;
+
+		long long llX = 0;
+		long long llY = 0;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (pEvents[i].type == output::Event::Scroll)
+				{
+					this->llX += pEvents[i].iX;
+					this->llY += pEvents[i].iY;
+
+					this->ullScrolls++;
+				}
+			}
+
+			this->ullEvents += szCount;
+		}
+	};
+}
+
+// Wheel events the default profile sends per tick and the distance they cover, in units of 1/120 notch.
+int main()
+{
+	for (const int iRate : { 125, 250, 1000 })
+	{
+		std::shared_ptr<Wheel> pWheel = std::make_shared<Wheel>();
+
+		output::setSink(pWheel);
+
+		std::shared_ptr<Clock> pClock = std::make_shared<Clock>();
+
+		gp::GamepadPtr gamepad = gp::makeDefault(0, true, pClock);
+
+		const int iTicks = 4 * iRate;
+
+		for (int iTick = 0; iTick <= iTicks; iTick++)
+		{
+			gamepad->update();
+
+			output::commit();
+
+			pClock->advance(std::chrono::nanoseconds(1000000000 / iRate));
+		}
+
+		std::printf("%4d Hz  %5.2f wheel events/tick  %5.2f events/tick  wheel %6lld %6lld\n", iRate, static_cast<double>(pWheel->ullScrolls) / iTicks, static_cast<double>(pWheel->ullEvents) / iTicks, pWheel->llX, pWheel->llY);
+	}
+
+	return 0;
+}
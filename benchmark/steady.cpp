@@ -0,0 +1,139 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mock.hpp"
+
+#include "interface.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+
+namespace
+{
+	thread_local bool bCounting = false;
+
+	unsigned long long ullAllocations = 0;
+}
+
+// Counts the allocations gamepadsUpdate() makes while bCounting is set on its thread.
+void* operator new(const std::size_t szSize)
+{
+	if (bCounting)
+	{
+		ullAllocations++;
+	}
+
+	if (void* pMemory = std::malloc(szSize ? szSize : 1))
+	{
+		return pMemory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+namespace
+{
+	const int iPads = 4;
+
+	const int iWarmup = 1000;
+
+	const int iTicks = 20000;
+
+	// Raw states of one synthetic pad, the playback backend loops over them for every pad.
+	void write(const char* szPath)
+	{
+		bench::Backend backend(1);
+
+		std::ofstream file(szPath, std::ios::binary);
+
+		for (int i = 0; i < 4096; i++)
+		{
+			gp::State state;
+
+			backend.read(0, state);
+
+			file.write(reinterpret_cast<const char*>(&state), sizeof(state));
+
+			backend.tick();
+		}
+	}
+}
+
+// Runs the steady-state poll and commit loop through the C interface and fails if a tick allocates after the warm-up.
+int main()
+{
+	const char* szPath = "steady.states";
+
+	write(szPath);
+
+	output::setSink(std::make_shared<bench::Sink>());
+
+	gamepadsPlayback(szPath, iPads);
+
+	gamepadsInitialize();
+
+	for (int iPosition = 0; iPosition < gamepadsCount(); iPosition++)
+	{
+		gamepadEnable(gamepadsIdAt(iPosition), 1);
+	}
+
+	// The warm-up applies the enable commands and lets lazily grown buffers reach their steady-state size.
+	for (int i = 0; i < iWarmup; i++)
+	{
+		gamepadsUpdate();
+	}
+
+	bCounting = true;
+
+	const double dTick = bench::measure(iTicks, [] { gamepadsUpdate(); });
+
+	bCounting = false;
+
+	const unsigned long long ullEvents = gamepadsOutputQueued();
+
+	gamepadsTerminate();
+
+	std::printf("%d pads  %d ticks  %10.1f ns/tick  %llu events  %llu allocations\n", iPads, iTicks, dTick, ullEvents, ullAllocations);
+
+	if (ullAllocations != 0)
+	{
+		std::printf("steady-state ticks allocated\n");
+
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,259 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gamepad.hpp"
+#include "output.hpp"
+#include "switcher.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	thread_local bool bCounting = false;
+
+	unsigned long long ullAllocations = 0;
+}
+
+// Counts the allocations the polling loop makes while bCounting is set on its thread.
+void* operator new(const std::size_t szSize)
+{
+	if (bCounting)
+	{
+		ullAllocations++;
+	}
+
+	if (void* pMemory = std::malloc(szSize ? szSize : 1))
+	{
+		return pMemory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+namespace
+{
+	// A is held on every pad the whole time.
+	class Held : public gp::Backend
+	{
+	public:
+		int count() const override
+		{
+			return 4;
+		}
+
+		bool read(const int iIndex, gp::State& state) override
+		{
+			state = gp::State();
+
+			state.wButtons = 1u << gp::Button::A;
+
+			return iIndex >= 0 && iIndex < 4;
+		}
+	};
+
+	// Keeps the buttons and keys the pads hold, a switch has to release A under the old binding before the new one presses it.
+	class Pressed : public output::Sink
+	{
+	public:
+		bool bHeld[2][1024] = {};
+
+		std::size_t szHeld = 0;
+		std::size_t szMostHeld = 0;
+
+		unsigned long long ullPresses = 0;
+		unsigned long long ullReleases = 0;
+
+		void commit(const output::Event* pEvents, const std::size_t szCount) override
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				const output::Event& event = pEvents[i];
+
+				const bool bPress = event.type == output::Event::ButtonPress || event.type == output::Event::KeyPress;
+				const bool bRelease = event.type == output::Event::ButtonRelease || event.type == output::Event::KeyRelease;
+
+				if ((!bPress && !bRelease) || event.uCode >= std::size(this->bHeld[0]))
+				{
+					continue;
+				}
+
+				bool& bHeld = this->bHeld[event.type == output::Event::KeyPress || event.type == output::Event::KeyRelease][event.uCode];
+
+				if (bPress && !bHeld)
+				{
+					this->szHeld++;
+				}
+				else if (!bPress && bHeld)
+				{
+					this->szHeld--;
+				}
+
+				bHeld = bPress;
+
+				(bPress ? this->ullPresses : this->ullReleases)++;
+
+				this->szMostHeld = std::max(this->szMostHeld, this->szHeld);
+			}
+		}
+	};
+}
+
+// Moves a fake focus between applications every 40 ms while four pads hold A, then reports the switches, how many
+// of them needed a lookup, whether anything stayed held across a switch and what the polling loop allocated.
+int main()
+{
+	std::ofstream("default.profile") << "button A mouse Left\nstick Left motion Move 1000\n";
+	std::ofstream("game.profile") << "button A key Space\nstick Left motion Move 1600 curve power 2\n";
+	std::ofstream("editor.profile") << "button A key Return\nstick Right motion Scroll 800\n";
+	std::ofstream("switch.applications") << "# application  profile\nGame.exe game.profile\neditor   editor.profile  # any case, .exe optional\n";
+
+	gp::FakeFocusPtr pFocus = gp::makeFakeFocus();
+
+	pFocus->focus(1, 1, "explorer.exe");
+
+	gp::profile::SwitcherPtr pSwitcher = gp::profile::makeSwitcher(pFocus, gp::profile::makeWatcher("default.profile"), gp::profile::loadRules("switch.applications"), std::chrono::milliseconds(2));
+
+	std::shared_ptr<Pressed> pPressed = std::make_shared<Pressed>();
+
+	output::setSink(pPressed);
+
+	std::shared_ptr<Held> pHeld = std::make_shared<Held>();
+
+	std::vector<gp::GamepadPtr> vGamepads;
+
+	for (int i = 0; i < 4; i++)
+	{
+		vGamepads.push_back(gp::make(i, true, pHeld));
+	}
+
+	// Each application gets a few windows over the run, with a new process id and new windows every other round.
+	const std::pair<std::uint32_t, const char*> applications[] = { { 10, "game.exe" }, { 20, "editor" }, { 30, "explorer.exe" }, { 11, "GAME.EXE" }, { 20, "editor" }, { 31, "shell" } };
+
+	const gp::profile::Profile* pProfile = nullptr;
+
+	stats::Histogram switchHistogram;
+
+	unsigned long long ullSwitches = 0;
+	unsigned long long ullSwitchAllocations = 0;
+	unsigned long long ullTickAllocations = 0;
+
+	const int iTicks = 3000;
+
+	for (int iTick = 0; iTick < iTicks; iTick++)
+	{
+		if (iTick % 40 == 0)
+		{
+			const std::size_t szWindow = (iTick / 40) % std::size(applications);
+			const std::uint32_t uRound = (iTick / 40 / std::size(applications)) % 2;
+
+			pFocus->focus(1000 + uRound * 100 + szWindow, applications[szWindow].first + uRound * 100, applications[szWindow].second);
+		}
+
+		// The first round through every profile grows the tables, only the rest has to run without allocating.
+		bCounting = iTick >= 1000;
+
+		const unsigned long long ullBefore = ullAllocations;
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		const gp::profile::Profile* pLatest = pSwitcher->acquire();
+
+		const bool bSwitch = pLatest != pProfile;
+
+		if (bSwitch)
+		{
+			pProfile = pLatest;
+
+			for (const gp::GamepadPtr& gamepad : vGamepads)
+			{
+				gamepad->adopt(pProfile->bindings());
+			}
+
+			switchHistogram.record(std::chrono::steady_clock::now() - tStart);
+
+			ullSwitches++;
+		}
+
+		for (const gp::GamepadPtr& gamepad : vGamepads)
+		{
+			gamepad->update();
+		}
+
+		output::commit();
+
+		(bSwitch ? ullSwitchAllocations : ullTickAllocations) += ullAllocations - ullBefore;
+
+		bCounting = false;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	output::setSink(nullptr);
+
+	// A new window of another application in the process id the game had, it must not inherit the game's profile.
+	pFocus->focus(2000, 10, "game.exe");
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	const gp::profile::Profile* pGame = pSwitcher->acquire();
+
+	pFocus->focus(2001, 10, "notepad.exe");
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	const bool bReused = pSwitcher->acquire() != pGame;
+
+	const gp::profile::Switcher::Statistics statistics = pSwitcher->statistics();
+
+	std::printf("switches %llu (%llu seen by the switcher)  lookups %llu  application() calls %llu\n", ullSwitches, statistics.ullSwitches, statistics.ullLookups, pFocus->lookups());
+	std::printf("presses %llu  releases %llu  most held at once %zu (4 pads share one code per profile)\n", pPressed->ullPresses, pPressed->ullReleases, pPressed->szMostHeld);
+	std::printf("reused process id  %s\n", bReused ? "ok" : "STALE");
+	std::printf("allocations after warm-up: %llu in switching ticks, %llu in other ticks\n", ullSwitchAllocations, ullTickAllocations);
+	std::printf("switch 4 p50 %8.3f  p99 %8.3f  max %8.3f us  (%llu)\n",
+		std::chrono::duration<double, std::micro>(switchHistogram.percentile(50.0)).count(),
+		std::chrono::duration<double, std::micro>(switchHistogram.percentile(99.0)).count(),
+		std::chrono::duration<double, std::micro>(switchHistogram.max()).count(),
+		static_cast<unsigned long long>(switchHistogram.count()));
+
+	return bReused ? 0 : 1;
+}
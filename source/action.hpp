@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <span>
+
+namespace gp
+{
+	struct Action
+	{
+		typedef enum : std::uint8_t
+		{
+			None,
+			MouseButton,
+			MouseScroll,
+			MouseMotion,
+			Key,
+			Event,
+			Combination,
+			Function,
+			Callback,
+			Count
+		} Type;
+
+		Type type = None;
+
+		std::uint32_t uPress = 0;
+		std::uint32_t uRelease = 0;
+	};
+
+	template <typename T, const std::size_t szSlots>
+	class Bindings
+	{
+	private:
+		std::vector<T> vItems;
+
+		std::uint32_t uOffsets[szSlots + 1] = {};
+
+	public:
+		void insert(const std::size_t szSlot, const T& item)
+		{
+			this->vItems.insert(this->vItems.begin() + this->uOffsets[szSlot + 1], item);
+
+			for (std::size_t i = szSlot + 1; i <= szSlots; i++)
+			{
+				this->uOffsets[i]++;
+			}
+		}
+
+		std::span<T> operator[](const std::size_t szSlot)
+		{
+			return std::span<T>(this->vItems.data() + this->uOffsets[szSlot], this->uOffsets[szSlot + 1] - this->uOffsets[szSlot]);
+		}
+
+		std::span<const T> operator[](const std::size_t szSlot) const
+		{
+			return std::span<const T>(this->vItems.data() + this->uOffsets[szSlot], this->uOffsets[szSlot + 1] - this->uOffsets[szSlot]);
+		}
+
+		std::span<T> all()
+		{
+			return std::span<T>(this->vItems);
+		}
+
+		std::size_t size() const
+		{
+			return this->vItems.size();
+		}
+	};
+}
@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "backend.hpp"
+#include "hotplug.hpp"
+
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+namespace gp
+{
+	bool Backend::isConcurrent() const
+	{
+		return false;
+	}
+
+	bool Backend::isEventDriven() const
+	{
+		return false;
+	}
+
+	bool Backend::wait(const int iTimeout)
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		if (iTimeout < 0)
+		{
+			this->condition.wait(lock, [this]() { return this->bWoken; });
+		}
+		else
+		{
+			this->condition.wait_for(lock, std::chrono::milliseconds(iTimeout), [this]() { return this->bWoken; });
+		}
+
+		this->bWoken = false;
+
+		return true;
+	}
+
+	void Backend::wake()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			this->bWoken = true;
+		}
+
+		this->condition.notify_one();
+	}
+
+	bool Backend::waitInput(const int, const std::chrono::microseconds usTimeout)
+	{
+		std::this_thread::sleep_for(usTimeout);
+
+		return true;
+	}
+
+	bool Backend::isPaced() const
+	{
+		return false;
+	}
+
+	bool Backend::isHotplug() const
+	{
+		return false;
+	}
+
+	std::size_t Backend::changes(Change*, const std::size_t)
+	{
+		return 0;
+	}
+
+	std::chrono::steady_clock::time_point Backend::now() const
+	{
+		return std::chrono::steady_clock::now();
+	}
+
+	class FileBackend : public Backend
+	{
+	private:
+		std::vector<State> vStates;
+
+		std::vector<std::size_t> vPositions;
+
+	public:
+		FileBackend(const std::string& sPath, const int iCount) :
+			vPositions(static_cast<std::size_t>(std::max(iCount, 0)), 0)
+		{
+			std::ifstream file(sPath, std::ios::binary);
+
+			const std::vector<char> vData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+			this->vStates.resize(vData.size() / sizeof(State));
+
+			std::memcpy(this->vStates.data(), vData.data(), this->vStates.size() * sizeof(State));
+		}
+
+		int count() const override
+		{
+			return static_cast<int>(this->vPositions.size());
+		}
+
+		bool isConcurrent() const override
+		{
+			return true;
+		}
+
+		bool read(const int iIndex, State& state) override
+		{
+			if (iIndex < 0 || iIndex >= this->count() || this->vStates.empty())
+			{
+				return false;
+			}
+
+			std::size_t& szPosition = this->vPositions[iIndex];
+
+			state = this->vStates[szPosition];
+
+			szPosition = (szPosition + 1) % this->vStates.size();
+
+			return true;
+		}
+	};
+
+	BackendPtr makeFileBackend(const std::string& sPath, const int iCount)
+	{
+		return std::make_shared<FileBackend>(sPath, iCount);
+	}
+
+	BackendPtr makeBackend()
+	{
+#ifdef _WIN32
+		return makeXInputBackend();
+#else
+		return makeEvdevBackend("/dev/input", 16, makeInotifyHotplug("/dev/input"));
+#endif
+	}
+
+	const BackendPtr& defaultBackend()
+	{
+		static const BackendPtr pBackend = makeBackend();
+
+		return pBackend;
+	}
+}
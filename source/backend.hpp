@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
+namespace gp
+{
+	// Normalized pad state, buttons are bit-indexed by Button::Name and axes use the XInput ranges.
+	struct State
+	{
+		std::uint16_t wButtons = 0;
+
+		std::uint8_t bLeftTrigger = 0;
+		std::uint8_t bRightTrigger = 0;
+
+		std::int16_t sThumbLX = 0;
+		std::int16_t sThumbLY = 0;
+		std::int16_t sThumbRX = 0;
+		std::int16_t sThumbRY = 0;
+	};
+
+	struct Change
+	{
+		typedef enum : int
+		{
+			Attached,
+			Detached,
+			Count
+		} Type;
+
+		Type type = Attached;
+
+		int iIndex = 0;
+
+		// When the device was first noticed, pads measure their attach latency against it.
+		std::chrono::steady_clock::time_point tSeen;
+	};
+
+	class Backend
+	{
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		bool bWoken = false;
+
+	public:
+		virtual ~Backend() = default;
+
+		virtual int count() const = 0;
+
+		virtual bool read(const int iIndex, State& state) = 0;
+
+		// Whether read() may run for different pad indices on different threads at the same time.
+		virtual bool isConcurrent() const;
+
+		// Event driven backends block in wait() until a device reports, polling backends just sleep for the timeout.
+		virtual bool isEventDriven() const;
+
+		// Waits up to iTimeout milliseconds (negative waits forever) and returns whether input is ready to be read.
+		virtual bool wait(const int iTimeout);
+
+		virtual void wake();
+
+		// Blocks until the pad at iIndex has input or usTimeout passes, false once its slot is empty. Backends without
+		// a descriptor per device just sleep for the timeout, event driven ones return as soon as the device reports.
+		virtual bool waitInput(const int iIndex, const std::chrono::microseconds usTimeout);
+
+		// Paced backends decide themselves when a disconnected slot is probed again, pads then read them on every tick.
+		virtual bool isPaced() const;
+
+		// Hotplug backends report every slot that gains or loses a device through changes(), empty slots are never read.
+		virtual bool isHotplug() const;
+
+		// Moves up to szCount pending changes into pChanges and returns how many there were.
+		virtual std::size_t changes(Change* pChanges, const std::size_t szCount);
+
+		// Clock the pads are timed against, replays substitute their virtual time.
+		virtual std::chrono::steady_clock::time_point now() const;
+	};
+
+	typedef std::shared_ptr<Backend> BackendPtr;
+
+	extern BackendPtr makeXInputBackend();
+
+	class Hotplug;
+
+	// Without a hotplug source empty slots rescan the directory whenever they are read.
+	extern BackendPtr makeEvdevBackend(const std::string& sDirectory = "/dev/input", const int iCount = 16, const std::shared_ptr<Hotplug>& pHotplug = nullptr);
+
+	extern BackendPtr makeFileBackend(const std::string& sPath, const int iCount = 1);
+
+	extern BackendPtr makeBackend();
+
+	extern const BackendPtr& defaultBackend();
+}
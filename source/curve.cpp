@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "curve.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gp
+{
+	Curve::Curve(const std::function<double(const double)>& fCurve)
+	{
+		for (std::size_t i = 0; i <= Size; i++)
+		{
+			this->dTable[i] = fCurve(static_cast<double>(i) / static_cast<double>(Size));
+
+			this->iTable[i] = static_cast<std::int32_t>(std::lround(std::clamp(this->dTable[i], -16.0, 16.0) * static_cast<double>(1 << One)));
+		}
+	}
+
+	CurvePtr makeCurve(const std::function<double(const double)>& fCurve)
+	{
+		if (!fCurve)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<const Curve>(fCurve);
+	}
+
+	CurvePtr makePowerCurve(const double dExponent)
+	{
+		return makeCurve([dExponent](const double dValue) {
+			return std::pow(dValue, dExponent);
+		});
+	}
+
+	CurvePtr makeExponentialCurve(const double dStrength)
+	{
+		if (std::abs(dStrength) < 1e-6)
+		{
+			return makePowerCurve(1.0);
+		}
+
+		return makeCurve([dStrength](const double dValue) {
+			return std::expm1(dStrength * dValue) / std::expm1(dStrength);
+		});
+	}
+
+	CurvePtr makeBezierCurve(const std::vector<Curve::Point>& vPoints)
+	{
+		if (vPoints.size() < 4)
+		{
+			return nullptr;
+		}
+
+		// Every segment is flattened into short lines, far finer than the table, and resampled like a point curve.
+		const std::size_t szSteps = 64;
+
+		std::vector<Curve::Point> vLines;
+
+		vLines.reserve((vPoints.size() - 1) / 3 * szSteps + 1);
+
+		for (std::size_t i = 0; i + 3 < vPoints.size(); i += 3)
+		{
+			const Curve::Point* pSegment = vPoints.data() + i;
+
+			for (std::size_t szStep = i == 0 ? 0 : 1; szStep <= szSteps; szStep++)
+			{
+				const double dT = static_cast<double>(szStep) / static_cast<double>(szSteps);
+				const double dU = 1.0 - dT;
+
+				const double dWeights[4] = {
+					dU * dU * dU,
+					3.0 * dU * dU * dT,
+					3.0 * dU * dT * dT,
+					dT * dT * dT
+				};
+
+				Curve::Point point;
+
+				for (std::size_t j = 0; j < 4; j++)
+				{
+					point.dX += dWeights[j] * pSegment[j].dX;
+					point.dY += dWeights[j] * pSegment[j].dY;
+				}
+
+				vLines.push_back(point);
+			}
+		}
+
+		return makePointCurve(std::move(vLines));
+	}
+
+	CurvePtr makePointCurve(std::vector<Curve::Point> vPoints)
+	{
+		if (vPoints.empty())
+		{
+			return nullptr;
+		}
+
+		std::stable_sort(vPoints.begin(), vPoints.end(), [](const Curve::Point& first, const Curve::Point& second) {
+			return first.dX < second.dX;
+		});
+
+		return makeCurve([vPoints = std::move(vPoints)](const double dValue) {
+			const auto it = std::upper_bound(vPoints.begin(), vPoints.end(), dValue, [](const double dX, const Curve::Point& point) {
+				return dX < point.dX;
+			});
+
+			if (it == vPoints.begin())
+			{
+				return vPoints.front().dY;
+			}
+
+			if (it == vPoints.end())
+			{
+				return vPoints.back().dY;
+			}
+
+			const Curve::Point& first = *(it - 1);
+			const Curve::Point& second = *it;
+
+			if (second.dX - first.dX <= 0.0)
+			{
+				return second.dY;
+			}
+
+			return first.dY + (second.dY - first.dY) * (dValue - first.dX) / (second.dX - first.dX);
+		});
+	}
+}
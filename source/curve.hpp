@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gp
+{
+	// Response curve over the deadzoned stick deflection, sampled once into a table so evaluating it is one interpolated lookup.
+	class Curve
+	{
+	public:
+		static constexpr std::size_t Size = 256;
+
+		// Fixed point values carry 15 fraction bits, 1 << One is full deflection.
+		static constexpr int One = 15;
+
+		struct Point
+		{
+			double dX = 0.0;
+			double dY = 0.0;
+		};
+
+	private:
+		double dTable[Size + 1] = {};
+
+		std::int32_t iTable[Size + 1] = {};
+
+	public:
+		Curve(const std::function<double(const double)>& fCurve);
+
+		// Clamps dValue to [0, 1] and interpolates linearly between the two nearest samples.
+		double operator()(const double dValue) const
+		{
+			const double dPosition = (dValue <= 0.0 ? 0.0 : dValue >= 1.0 ? 1.0 : dValue) * static_cast<double>(Size);
+
+			const std::size_t szIndex = std::min(static_cast<std::size_t>(dPosition), Size - 1);
+
+			const double dFraction = dPosition - static_cast<double>(szIndex);
+
+			return this->dTable[szIndex] + (this->dTable[szIndex + 1] - this->dTable[szIndex]) * dFraction;
+		}
+
+		// Same lookup on the fixed point table for the integer stick pipeline, which saturates at 16.
+		std::int32_t operator()(const std::int32_t iValue) const
+		{
+			constexpr int iShift = One - 8;
+
+			static_assert(Size == 1 << 8);
+
+			const std::int32_t iPosition = std::clamp(iValue, 0, 1 << One);
+
+			const std::int32_t iIndex = std::min(iPosition >> iShift, static_cast<std::int32_t>(Size - 1));
+
+			const std::int32_t iFraction = iPosition - (iIndex << iShift);
+
+			return this->iTable[iIndex] + static_cast<std::int32_t>((static_cast<std::int64_t>(this->iTable[iIndex + 1] - this->iTable[iIndex]) * iFraction) >> iShift);
+		}
+	};
+
+	typedef std::shared_ptr<const Curve> CurvePtr;
+
+	extern CurvePtr makeCurve(const std::function<double(const double)>& fCurve);
+
+	// x^dExponent, above 1 slows small deflections down for precise aiming.
+	extern CurvePtr makePowerCurve(const double dExponent);
+
+	// (e^(dStrength x) - 1) / (e^dStrength - 1), flat near the center and steep towards full deflection.
+	extern CurvePtr makeExponentialCurve(const double dStrength);
+
+	// Cubic segments given as start, two control points and end, consecutive segments share their end points.
+	extern CurvePtr makeBezierCurve(const std::vector<Curve::Point>& vPoints);
+
+	// Straight lines between the points, which are sorted by x first.
+	extern CurvePtr makePointCurve(std::vector<Curve::Point> vPoints);
+}
@@ -0,0 +1,631 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "backend.hpp"
+#include "hotplug.hpp"
+
+#ifdef __linux__
+
+#include "gamepad.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <linux/input.h>
+
+namespace gp
+{
+	class EvdevBackend : public Backend
+	{
+	private:
+		struct Device
+		{
+			int iDescriptor = -1;
+
+			std::string sPath;
+
+			input_absinfo absInfos[ABS_CNT] = {};
+
+			State state;
+		};
+
+		std::string sDirectory;
+
+		std::vector<Device> devices;
+
+		// Guards which slot owns which device. A device is opened and closed holding this and its own lock, its events
+		// and state only under its own lock, so slots is always taken first.
+		std::mutex slots;
+
+		std::vector<std::mutex> owners;
+
+		HotplugPtr pHotplug;
+
+		std::vector<Change> vChanges;
+
+		int iEpoll = -1;
+		int iWake = -1;
+
+		static bool testBit(const unsigned long* ulBits, const int iBit)
+		{
+			const int iBitsPerLong = static_cast<int>(sizeof(unsigned long) * 8);
+
+			return (ulBits[iBit / iBitsPerLong] >> (iBit % iBitsPerLong)) & 1ul;
+		}
+
+		static bool isGamepad(const int iDescriptor)
+		{
+			unsigned long ulKeyBits[KEY_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+			unsigned long ulAbsBits[ABS_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+
+			if (ioctl(iDescriptor, EVIOCGBIT(EV_KEY, sizeof(ulKeyBits)), ulKeyBits) < 0 || ioctl(iDescriptor, EVIOCGBIT(EV_ABS, sizeof(ulAbsBits)), ulAbsBits) < 0)
+			{
+				return false;
+			}
+
+			return testBit(ulKeyBits, BTN_GAMEPAD) && testBit(ulAbsBits, ABS_X) && testBit(ulAbsBits, ABS_Y);
+		}
+
+		static std::int16_t toThumb(const input_absinfo& absInfo, const int iValue)
+		{
+			if (absInfo.maximum <= absInfo.minimum)
+			{
+				return 0;
+			}
+
+			const double dNormalized = static_cast<double>(std::clamp(iValue, absInfo.minimum, absInfo.maximum) - absInfo.minimum) / static_cast<double>(absInfo.maximum - absInfo.minimum);
+
+			return static_cast<std::int16_t>(dNormalized * 65535.0 - 32768.0);
+		}
+
+		static std::int16_t toThumbInverted(const input_absinfo& absInfo, const int iValue)
+		{
+			return static_cast<std::int16_t>(-1 - toThumb(absInfo, iValue));
+		}
+
+		static std::uint8_t toTrigger(const input_absinfo& absInfo, const int iValue)
+		{
+			if (absInfo.maximum <= absInfo.minimum)
+			{
+				return 0;
+			}
+
+			return static_cast<std::uint8_t>((std::clamp(iValue, absInfo.minimum, absInfo.maximum) - absInfo.minimum) * 255 / (absInfo.maximum - absInfo.minimum));
+		}
+
+		static void setButton(State& state, const Button::Name button, const bool bPressed)
+		{
+			if (bPressed)
+			{
+				state.wButtons |= static_cast<std::uint16_t>(1u << button);
+			}
+			else
+			{
+				state.wButtons &= static_cast<std::uint16_t>(~(1u << button));
+			}
+		}
+
+		static void applyKey(State& state, const int iCode, const bool bPressed)
+		{
+			switch (iCode)
+			{
+			case BTN_SOUTH: return setButton(state, Button::A, bPressed);
+			case BTN_EAST: return setButton(state, Button::B, bPressed);
+			case BTN_WEST: return setButton(state, Button::X, bPressed);
+			case BTN_NORTH: return setButton(state, Button::Y, bPressed);
+			case BTN_TL: return setButton(state, Button::ShoulderLeft, bPressed);
+			case BTN_TR: return setButton(state, Button::ShoulderRight, bPressed);
+			case BTN_SELECT: return setButton(state, Button::Back, bPressed);
+			case BTN_START: return setButton(state, Button::Start, bPressed);
+			case BTN_THUMBL: return setButton(state, Button::ThumbLeft, bPressed);
+			case BTN_THUMBR: return setButton(state, Button::ThumbRight, bPressed);
+			case BTN_DPAD_UP: return setButton(state, Button::DpadUp, bPressed);
+			case BTN_DPAD_DOWN: return setButton(state, Button::DpadDown, bPressed);
+			case BTN_DPAD_LEFT: return setButton(state, Button::DpadLeft, bPressed);
+			case BTN_DPAD_RIGHT: return setButton(state, Button::DpadRight, bPressed);
+			case BTN_TL2:
+			{
+				state.bLeftTrigger = bPressed ? 255 : 0;
+
+				break;
+			}
+			case BTN_TR2:
+			{
+				state.bRightTrigger = bPressed ? 255 : 0;
+
+				break;
+			}
+			default:
+			{
+				break;
+			}
+			}
+		}
+
+		static void applyAbs(Device& device, const int iCode, const int iValue)
+		{
+			if (iCode < 0 || iCode >= ABS_CNT)
+			{
+				return;
+			}
+
+			const input_absinfo& absInfo = device.absInfos[iCode];
+
+			State& state = device.state;
+
+			switch (iCode)
+			{
+			case ABS_X: state.sThumbLX = toThumb(absInfo, iValue); break;
+			case ABS_Y: state.sThumbLY = toThumbInverted(absInfo, iValue); break;
+			case ABS_RX: state.sThumbRX = toThumb(absInfo, iValue); break;
+			case ABS_RY: state.sThumbRY = toThumbInverted(absInfo, iValue); break;
+			case ABS_Z: case ABS_BRAKE: state.bLeftTrigger = toTrigger(absInfo, iValue); break;
+			case ABS_RZ: case ABS_GAS: state.bRightTrigger = toTrigger(absInfo, iValue); break;
+			case ABS_HAT0X:
+			{
+				setButton(state, Button::DpadLeft, iValue < 0);
+				setButton(state, Button::DpadRight, iValue > 0);
+
+				break;
+			}
+			case ABS_HAT0Y:
+			{
+				setButton(state, Button::DpadUp, iValue < 0);
+				setButton(state, Button::DpadDown, iValue > 0);
+
+				break;
+			}
+			default:
+			{
+				break;
+			}
+			}
+		}
+
+		static void synchronize(Device& device)
+		{
+			device.state = State();
+
+			unsigned long ulKeyStates[KEY_CNT / (sizeof(unsigned long) * 8) + 1] = {};
+
+			if (ioctl(device.iDescriptor, EVIOCGKEY(sizeof(ulKeyStates)), ulKeyStates) >= 0)
+			{
+				for (int iCode = BTN_MISC; iCode < KEY_CNT; iCode++)
+				{
+					if (testBit(ulKeyStates, iCode))
+					{
+						applyKey(device.state, iCode, true);
+					}
+				}
+			}
+
+			for (const int iCode : { ABS_X, ABS_Y, ABS_RX, ABS_RY, ABS_Z, ABS_RZ, ABS_BRAKE, ABS_GAS, ABS_HAT0X, ABS_HAT0Y })
+			{
+				if (ioctl(device.iDescriptor, EVIOCGABS(iCode), &device.absInfos[iCode]) >= 0)
+				{
+					applyAbs(device, iCode, device.absInfos[iCode].value);
+				}
+			}
+		}
+
+		void close(Device& device)
+		{
+			if (device.iDescriptor >= 0)
+			{
+				::close(device.iDescriptor);
+			}
+
+			device = Device();
+		}
+
+		void scan()
+		{
+			DIR* pDirectory = opendir(this->sDirectory.c_str());
+
+			if (!pDirectory)
+			{
+				return;
+			}
+
+			while (const dirent* pEntry = readdir(pDirectory))
+			{
+				if (std::strncmp(pEntry->d_name, "event", 5) != 0)
+				{
+					continue;
+				}
+
+				const std::string sPath = this->sDirectory + "/" + pEntry->d_name;
+
+				if (std::any_of(std::begin(this->devices), std::end(this->devices), [&sPath](const Device& device) { return device.iDescriptor >= 0 && device.sPath == sPath; }))
+				{
+					continue;
+				}
+
+				if (!this->attach(sPath, std::chrono::steady_clock::now()))
+				{
+					if (std::none_of(std::begin(this->devices), std::end(this->devices), [](const Device& device) { return device.iDescriptor < 0; }))
+					{
+						break;
+					}
+				}
+			}
+
+			closedir(pDirectory);
+		}
+
+		bool attach(const std::string& sPath, const std::chrono::steady_clock::time_point tSeen)
+		{
+			const std::vector<Device>::iterator pFree = std::find_if(std::begin(this->devices), std::end(this->devices), [](const Device& device) { return device.iDescriptor < 0; });
+
+			if (pFree == std::end(this->devices))
+			{
+				return false;
+			}
+
+			const int iDescriptor = open(sPath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+			if (iDescriptor < 0)
+			{
+				return false;
+			}
+
+			if (!isGamepad(iDescriptor))
+			{
+				::close(iDescriptor);
+
+				return false;
+			}
+
+			std::lock_guard<std::mutex> lock(this->owners[static_cast<std::size_t>(pFree - std::begin(this->devices))]);
+
+			pFree->iDescriptor = iDescriptor;
+			pFree->sPath = sPath;
+
+			if (this->iEpoll >= 0)
+			{
+				epoll_event event = {};
+
+				event.events = EPOLLIN;
+				event.data.fd = iDescriptor;
+
+				epoll_ctl(this->iEpoll, EPOLL_CTL_ADD, iDescriptor, &event);
+			}
+
+			synchronize(*pFree);
+
+			if (this->pHotplug)
+			{
+				this->vChanges.push_back({ Change::Attached, static_cast<int>(pFree - std::begin(this->devices)), tSeen });
+			}
+
+			return true;
+		}
+
+		// Called holding slots, waits for a read of the device in progress.
+		void detach(Device& device)
+		{
+			const std::size_t szIndex = static_cast<std::size_t>(&device - this->devices.data());
+
+			if (this->pHotplug)
+			{
+				this->vChanges.push_back({ Change::Detached, static_cast<int>(szIndex), std::chrono::steady_clock::now() });
+			}
+
+			std::lock_guard<std::mutex> lock(this->owners[szIndex]);
+
+			this->close(device);
+		}
+
+	public:
+		EvdevBackend(const std::string& sDirectory, const int iCount, const HotplugPtr& pHotplug) :
+			sDirectory(sDirectory), devices(static_cast<std::size_t>(std::max(iCount, 0))), owners(static_cast<std::size_t>(std::max(iCount, 0))), pHotplug(pHotplug), iEpoll(epoll_create1(EPOLL_CLOEXEC)), iWake(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+		{
+			if (this->iEpoll >= 0 && this->iWake >= 0)
+			{
+				epoll_event event = {};
+
+				event.events = EPOLLIN;
+				event.data.fd = this->iWake;
+
+				epoll_ctl(this->iEpoll, EPOLL_CTL_ADD, this->iWake, &event);
+
+				if (this->pHotplug && this->pHotplug->descriptor() >= 0)
+				{
+					event.data.fd = this->pHotplug->descriptor();
+
+					epoll_ctl(this->iEpoll, EPOLL_CTL_ADD, this->pHotplug->descriptor(), &event);
+				}
+			}
+
+			this->scan();
+		}
+
+		~EvdevBackend()
+		{
+			for (Device& device : this->devices)
+			{
+				this->close(device);
+			}
+
+			if (this->iWake >= 0)
+			{
+				::close(this->iWake);
+			}
+
+			if (this->iEpoll >= 0)
+			{
+				::close(this->iEpoll);
+			}
+		}
+
+		bool isEventDriven() const override
+		{
+			return this->iEpoll >= 0 && this->iWake >= 0;
+		}
+
+		bool wait(const int iTimeout) override
+		{
+			if (!this->isEventDriven())
+			{
+				return Backend::wait(iTimeout);
+			}
+
+			epoll_event events[8];
+
+			const int iCount = epoll_wait(this->iEpoll, events, static_cast<int>(std::size(events)), iTimeout);
+
+			bool bReady = false;
+
+			for (int i = 0; i < iCount; i++)
+			{
+				if (events[i].data.fd == this->iWake)
+				{
+					eventfd_t value = 0;
+
+					eventfd_read(this->iWake, &value);
+				}
+				else if (this->pHotplug && events[i].data.fd == this->pHotplug->descriptor())
+				{
+					// Drained by changes(), the next update picks the device up.
+					bReady = true;
+				}
+				else
+				{
+					bReady = true;
+				}
+			}
+
+			return bReady;
+		}
+
+		void wake() override
+		{
+			if (!this->isEventDriven())
+			{
+				return Backend::wake();
+			}
+
+			eventfd_write(this->iWake, 1);
+		}
+
+		int count() const override
+		{
+			return static_cast<int>(this->devices.size());
+		}
+
+		bool waitInput(const int iIndex, const std::chrono::microseconds usTimeout) override
+		{
+			if (iIndex < 0 || iIndex >= this->count())
+			{
+				return false;
+			}
+
+			pollfd descriptor = {};
+
+			{
+				std::lock_guard<std::mutex> lock(this->owners[iIndex]);
+
+				descriptor.fd = this->devices[iIndex].iDescriptor;
+			}
+
+			if (descriptor.fd < 0)
+			{
+				return false;
+			}
+
+			// A device closed meanwhile only ends the wait early or late, read() checks the slot again under its lock.
+			descriptor.events = POLLIN;
+
+			::poll(&descriptor, 1, static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(usTimeout).count()));
+
+			return true;
+		}
+
+		bool isHotplug() const override
+		{
+			return this->pHotplug != nullptr;
+		}
+
+		std::size_t changes(Change* pChanges, const std::size_t szCount) override
+		{
+			std::lock_guard<std::mutex> lock(this->slots);
+
+			Hotplug::Notification notification;
+
+			while (this->pHotplug && this->pHotplug->next(notification))
+			{
+				if (std::strncmp(notification.sName.c_str(), "event", 5) != 0)
+				{
+					continue;
+				}
+
+				const std::string sPath = this->sDirectory + "/" + notification.sName;
+
+				const std::vector<Device>::iterator pDevice = std::find_if(std::begin(this->devices), std::end(this->devices), [&sPath](const Device& device) { return device.iDescriptor >= 0 && device.sPath == sPath; });
+
+				if (notification.type == Hotplug::Notification::Removed)
+				{
+					if (pDevice != std::end(this->devices))
+					{
+						this->detach(*pDevice);
+					}
+				}
+				else if (pDevice == std::end(this->devices))
+				{
+					this->attach(sPath, notification.tSeen);
+				}
+			}
+
+			const std::size_t szMoved = std::min(szCount, this->vChanges.size());
+
+			std::copy_n(this->vChanges.begin(), szMoved, pChanges);
+
+			this->vChanges.erase(this->vChanges.begin(), this->vChanges.begin() + static_cast<std::ptrdiff_t>(szMoved));
+
+			return szMoved;
+		}
+
+		bool isConcurrent() const override
+		{
+			return true;
+		}
+
+		bool read(const int iIndex, State& state) override
+		{
+			if (iIndex < 0 || iIndex >= this->count())
+			{
+				return false;
+			}
+
+			Device& device = this->devices[iIndex];
+
+			if (!this->pHotplug)
+			{
+				std::lock_guard<std::mutex> lock(this->slots);
+
+				if (device.iDescriptor < 0)
+				{
+					this->scan();
+				}
+			}
+
+			std::unique_lock<std::mutex> lock(this->owners[iIndex]);
+
+			if (device.iDescriptor < 0)
+			{
+				return false;
+			}
+
+			input_event events[64];
+
+			while (true)
+			{
+				const ssize_t sRead = ::read(device.iDescriptor, events, sizeof(events));
+
+				if (sRead < 0)
+				{
+					if (errno == EINTR)
+					{
+						continue;
+					}
+
+					if (errno == EAGAIN)
+					{
+						break;
+					}
+
+					// Slots comes first, so the device is let go and its descriptor checked again once both are held.
+					const int iDescriptor = device.iDescriptor;
+
+					lock.unlock();
+
+					std::lock_guard<std::mutex> slotsLock(this->slots);
+
+					if (device.iDescriptor == iDescriptor)
+					{
+						this->detach(device);
+					}
+
+					return false;
+				}
+
+				const std::size_t szCount = static_cast<std::size_t>(sRead) / sizeof(input_event);
+
+				for (std::size_t i = 0; i < szCount; i++)
+				{
+					const input_event& event = events[i];
+
+					if (event.type == EV_KEY)
+					{
+						applyKey(device.state, event.code, event.value != 0);
+					}
+					else if (event.type == EV_ABS)
+					{
+						applyAbs(device, event.code, event.value);
+					}
+					else if (event.type == EV_SYN && event.code == SYN_DROPPED)
+					{
+						synchronize(device);
+					}
+				}
+
+				if (szCount < std::size(events))
+				{
+					break;
+				}
+			}
+
+			state = device.state;
+
+			return true;
+		}
+	};
+
+	BackendPtr makeEvdevBackend(const std::string& sDirectory, const int iCount, const HotplugPtr& pHotplug)
+	{
+		return std::make_shared<EvdevBackend>(sDirectory, iCount, pHotplug);
+	}
+}
+
+#else
+
+namespace gp
+{
+	BackendPtr makeEvdevBackend(const std::string&, const int, const HotplugPtr&)
+	{
+		return nullptr;
+	}
+}
+
+#endif
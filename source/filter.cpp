@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "filter.hpp"
+
+#include <cmath>
+#include <numbers>
+
+namespace gp
+{
+	OneEuro::OneEuro(const Smoothing& smoothing) :
+		smoothing(smoothing)
+	{
+
+	}
+
+	double OneEuro::alpha(const double dCutoff, const double dElapsed)
+	{
+		const double dTau = 1.0 / (2.0 * std::numbers::pi * dCutoff);
+
+		return 1.0 / (1.0 + dTau / dElapsed);
+	}
+
+	bool OneEuro::isEnabled() const
+	{
+		return this->smoothing.dMinimumCutoff > 0.0;
+	}
+
+	void OneEuro::filter(double& dX, double& dY, const double dElapsed)
+	{
+		if (!this->bPrimed || dElapsed <= 0.0)
+		{
+			if (!this->bPrimed)
+			{
+				this->dX = dX;
+				this->dY = dY;
+
+				this->bPrimed = true;
+			}
+
+			dX = this->dX;
+			dY = this->dY;
+
+			return;
+		}
+
+		// Both axes share one cutoff from the speed of the whole stick, so smoothing never bends the direction.
+		const double dDerivativeAlpha = alpha(this->smoothing.dDerivativeCutoff, dElapsed);
+
+		this->dDerivativeX += dDerivativeAlpha * ((dX - this->dX) / dElapsed - this->dDerivativeX);
+		this->dDerivativeY += dDerivativeAlpha * ((dY - this->dY) / dElapsed - this->dDerivativeY);
+
+		const double dSpeed = std::sqrt(this->dDerivativeX * this->dDerivativeX + this->dDerivativeY * this->dDerivativeY);
+
+		const double dAlpha = alpha(this->smoothing.dMinimumCutoff + this->smoothing.dBeta * dSpeed, dElapsed);
+
+		this->dX += dAlpha * (dX - this->dX);
+		this->dY += dAlpha * (dY - this->dY);
+
+		dX = this->dX;
+		dY = this->dY;
+	}
+
+	void OneEuro::reset()
+	{
+		this->bPrimed = false;
+
+		this->dX = 0.0;
+		this->dY = 0.0;
+
+		this->dDerivativeX = 0.0;
+		this->dDerivativeY = 0.0;
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+namespace gp
+{
+	struct Smoothing
+	{
+		// Cutoff in Hz while the stick rests, 0 turns smoothing off.
+		double dMinimumCutoff = 0.0;
+
+		// Additional cutoff in Hz per unit of stick speed (full deflections per second).
+		double dBeta = 0.0;
+
+		// Cutoff in Hz for the speed estimate itself.
+		double dDerivativeCutoff = 1.0;
+	};
+
+	// One Euro filter over a stick position: the cutoff rises with the speed of the stick,
+	// so jitter while holding still is smoothed heavily and fast motion passes with little lag.
+	class OneEuro
+	{
+	private:
+		Smoothing smoothing;
+
+		bool bPrimed = false;
+
+		double dX = 0.0;
+		double dY = 0.0;
+
+		double dDerivativeX = 0.0;
+		double dDerivativeY = 0.0;
+
+		static double alpha(const double dCutoff, const double dElapsed);
+
+	public:
+		OneEuro(const Smoothing& smoothing = Smoothing());
+
+		bool isEnabled() const;
+
+		// Filters the position in place, dElapsed is the time in seconds since the previous sample.
+		void filter(double& dX, double& dY, const double dElapsed);
+
+		void reset();
+	};
+}
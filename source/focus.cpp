@@ -0,0 +1,349 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "focus.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+
+namespace gp
+{
+	void FakeFocus::focus(const std::uint64_t ullHandle, const std::uint32_t uProcess, const std::string& sApplication)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->window.ullHandle = ullHandle;
+		this->window.uProcess = uProcess;
+
+		this->applications[uProcess] = sApplication;
+	}
+
+	Focus::Window FakeFocus::foreground()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		return this->window;
+	}
+
+	std::string FakeFocus::application(const Window& window)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->ullLookups++;
+
+		const auto iterator = this->applications.find(window.uProcess);
+
+		return iterator != this->applications.end() ? iterator->second : std::string();
+	}
+
+	unsigned long long FakeFocus::lookups()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		return this->ullLookups;
+	}
+
+	FakeFocusPtr makeFakeFocus()
+	{
+		return std::make_shared<FakeFocus>();
+	}
+
+	namespace
+	{
+		std::string fileName(const std::string& sPath)
+		{
+			return sPath.substr(sPath.find_last_of("/\\") + 1);
+		}
+	}
+
+#ifdef _WIN32
+	class Win32Focus : public Focus
+	{
+	public:
+		Window foreground() override
+		{
+			Window window;
+
+			const HWND hWnd = GetForegroundWindow();
+
+			if (hWnd)
+			{
+				DWORD dwProcess = 0;
+
+				GetWindowThreadProcessId(hWnd, &dwProcess);
+
+				window.ullHandle = reinterpret_cast<std::uintptr_t>(hWnd);
+				window.uProcess = dwProcess;
+			}
+
+			return window;
+		}
+
+		std::string application(const Window& window) override
+		{
+			const HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, window.uProcess);
+
+			if (!hProcess)
+			{
+				return std::string();
+			}
+
+			char szPath[MAX_PATH];
+
+			DWORD dwSize = MAX_PATH;
+
+			const BOOL bQueried = QueryFullProcessImageNameA(hProcess, 0, szPath, &dwSize);
+
+			CloseHandle(hProcess);
+
+			return bQueried ? fileName(std::string(szPath, dwSize)) : std::string();
+		}
+	};
+
+	FocusPtr makeWin32Focus()
+	{
+		return std::make_shared<Win32Focus>();
+	}
+
+	FocusPtr makeX11Focus()
+	{
+		return nullptr;
+	}
+#else
+	FocusPtr makeWin32Focus()
+	{
+		return nullptr;
+	}
+
+	class X11Focus : public Focus
+	{
+	private:
+		// The few Xlib declarations needed, so the headers are not required either.
+		typedef struct _XDisplay Display;
+		typedef unsigned long XWindow;
+		typedef unsigned long Atom;
+
+		struct XErrorEvent
+		{
+			int iType;
+			Display* pDisplay;
+			unsigned long ulResource;
+			unsigned long ulSerial;
+			unsigned char ucErrorCode;
+			unsigned char ucRequestCode;
+			unsigned char ucMinorCode;
+		};
+
+		typedef int (*FErrorHandler)(Display*, XErrorEvent*);
+
+		typedef Display* (*FOpenDisplay)(const char*);
+		typedef int (*FCloseDisplay)(Display*);
+		typedef XWindow (*FDefaultRootWindow)(Display*);
+		typedef Atom (*FInternAtom)(Display*, const char*, int);
+		typedef int (*FGetWindowProperty)(Display*, XWindow, Atom, long, long, int, Atom, Atom*, int*, unsigned long*, unsigned long*, unsigned char**);
+		typedef int (*FFree)(void*);
+		typedef FErrorHandler (*FSetErrorHandler)(FErrorHandler);
+
+		static constexpr Atom AtomWindow = 33;
+		static constexpr Atom AtomCardinal = 6;
+
+		static constexpr unsigned char BadWindow = 3;
+
+		// Xlib handlers are global, the one that was installed before keeps every error but BadWindow.
+		static inline FErrorHandler fPreviousHandler = nullptr;
+
+		void* pLibrary = nullptr;
+
+		Display* pDisplay = nullptr;
+
+		FCloseDisplay fCloseDisplay = nullptr;
+		FGetWindowProperty fGetWindowProperty = nullptr;
+		FFree fFree = nullptr;
+		FSetErrorHandler fSetErrorHandler = nullptr;
+
+		XWindow root = 0;
+
+		Atom activeWindow = 0;
+		Atom processId = 0;
+
+		// First 32 bit item of a window property, Xlib hands those out as longs.
+		unsigned long property(const XWindow window, const Atom property, const Atom type)
+		{
+			Atom actualType = 0;
+
+			int iFormat = 0;
+
+			unsigned long ulItems = 0;
+			unsigned long ulRemaining = 0;
+
+			unsigned char* pData = nullptr;
+
+			unsigned long ulValue = 0;
+
+			if (this->fGetWindowProperty(this->pDisplay, window, property, 0, 1, 0, type, &actualType, &iFormat, &ulItems, &ulRemaining, &pData) == 0 && pData)
+			{
+				if (actualType == type && iFormat == 32 && ulItems > 0)
+				{
+					ulValue = *reinterpret_cast<const unsigned long*>(pData);
+				}
+
+				this->fFree(pData);
+			}
+
+			return ulValue;
+		}
+
+		// The active window can be destroyed before its properties are read, the default handler would exit the process.
+		static int error(Display* pDisplay, XErrorEvent* pEvent)
+		{
+			if (pEvent->ucErrorCode == X11Focus::BadWindow || !X11Focus::fPreviousHandler)
+			{
+				return 0;
+			}
+
+			return X11Focus::fPreviousHandler(pDisplay, pEvent);
+		}
+
+	public:
+		X11Focus()
+		{
+			this->pLibrary = dlopen("libX11.so.6", RTLD_NOW | RTLD_LOCAL);
+
+			if (!this->pLibrary)
+			{
+				return;
+			}
+
+			const FOpenDisplay fOpenDisplay = reinterpret_cast<FOpenDisplay>(dlsym(this->pLibrary, "XOpenDisplay"));
+			const FDefaultRootWindow fDefaultRootWindow = reinterpret_cast<FDefaultRootWindow>(dlsym(this->pLibrary, "XDefaultRootWindow"));
+			const FInternAtom fInternAtom = reinterpret_cast<FInternAtom>(dlsym(this->pLibrary, "XInternAtom"));
+
+			this->fCloseDisplay = reinterpret_cast<FCloseDisplay>(dlsym(this->pLibrary, "XCloseDisplay"));
+			this->fGetWindowProperty = reinterpret_cast<FGetWindowProperty>(dlsym(this->pLibrary, "XGetWindowProperty"));
+			this->fFree = reinterpret_cast<FFree>(dlsym(this->pLibrary, "XFree"));
+			this->fSetErrorHandler = reinterpret_cast<FSetErrorHandler>(dlsym(this->pLibrary, "XSetErrorHandler"));
+
+			if (!fOpenDisplay || !fDefaultRootWindow || !fInternAtom || !this->fCloseDisplay || !this->fGetWindowProperty || !this->fFree || !this->fSetErrorHandler)
+			{
+				return;
+			}
+
+			this->pDisplay = fOpenDisplay(nullptr);
+
+			if (this->pDisplay)
+			{
+				X11Focus::fPreviousHandler = this->fSetErrorHandler(&X11Focus::error);
+
+				this->root = fDefaultRootWindow(this->pDisplay);
+
+				this->activeWindow = fInternAtom(this->pDisplay, "_NET_ACTIVE_WINDOW", 0);
+				this->processId = fInternAtom(this->pDisplay, "_NET_WM_PID", 0);
+			}
+		}
+
+		~X11Focus()
+		{
+			if (this->pDisplay)
+			{
+				this->fCloseDisplay(this->pDisplay);
+
+				this->fSetErrorHandler(X11Focus::fPreviousHandler);
+			}
+
+			if (this->pLibrary)
+			{
+				dlclose(this->pLibrary);
+			}
+		}
+
+		bool isValid() const
+		{
+			return this->pDisplay != nullptr;
+		}
+
+		Window foreground() override
+		{
+			Window window;
+
+			window.ullHandle = this->property(this->root, this->activeWindow, X11Focus::AtomWindow);
+
+			if (window.ullHandle)
+			{
+				window.uProcess = static_cast<std::uint32_t>(this->property(window.ullHandle, this->processId, X11Focus::AtomCardinal));
+			}
+
+			return window;
+		}
+
+		std::string application(const Window& window) override
+		{
+			if (!window.uProcess)
+			{
+				return std::string();
+			}
+
+			const std::string sProcess = "/proc/" + std::to_string(window.uProcess);
+
+			char szPath[4096];
+
+			const ssize_t iLength = readlink((sProcess + "/exe").c_str(), szPath, sizeof(szPath));
+
+			if (iLength > 0)
+			{
+				return fileName(std::string(szPath, static_cast<std::size_t>(iLength)));
+			}
+
+			// Processes of other users hide their executable, the name the kernel keeps is cut to 15 characters.
+			std::string sName;
+
+			std::getline(std::ifstream(sProcess + "/comm"), sName);
+
+			return sName;
+		}
+	};
+
+	FocusPtr makeX11Focus()
+	{
+		std::shared_ptr<X11Focus> pFocus = std::make_shared<X11Focus>();
+
+		return pFocus->isValid() ? pFocus : nullptr;
+	}
+#endif
+
+	FocusPtr makeFocus()
+	{
+#ifdef _WIN32
+		return makeWin32Focus();
+#else
+		return makeX11Focus();
+#endif
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace gp
+{
+	// Tells which application has the keyboard focus.
+	class Focus
+	{
+	public:
+		struct Window
+		{
+			std::uint64_t ullHandle = 0;
+
+			std::uint32_t uProcess = 0;
+		};
+
+		virtual ~Focus() = default;
+
+		// Foreground window and its process, both 0 when nothing has the focus or the desktop cannot tell.
+		virtual Window foreground() = 0;
+
+		// Executable of the window's process without directory, empty if it cannot be found.
+		virtual std::string application(const Window& window) = 0;
+	};
+
+	typedef std::shared_ptr<Focus> FocusPtr;
+
+	// The focus is moved by hand, for tests and benchmarks.
+	class FakeFocus : public Focus
+	{
+	private:
+		std::mutex mutex;
+
+		Window window;
+
+		std::unordered_map<std::uint32_t, std::string> applications;
+
+		unsigned long long ullLookups = 0;
+
+	public:
+		void focus(const std::uint64_t ullHandle, const std::uint32_t uProcess, const std::string& sApplication);
+
+		Window foreground() override;
+
+		std::string application(const Window& window) override;
+
+		// Calls of application(), the switcher only makes them for windows it has not seen.
+		unsigned long long lookups();
+	};
+
+	typedef std::shared_ptr<FakeFocus> FakeFocusPtr;
+
+	extern FocusPtr makeWin32Focus();
+
+	// Reads _NET_ACTIVE_WINDOW and _NET_WM_PID through libX11, loaded at run time so there is no build dependency, nullptr without a display.
+	extern FocusPtr makeX11Focus();
+
+	extern FakeFocusPtr makeFakeFocus();
+
+	extern FocusPtr makeFocus();
+}
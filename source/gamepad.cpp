@@ -23,105 +23,460 @@
  */
 
 #include "gamepad.hpp"
+#include "output.hpp"
 
 #include <limits>
 #include <cmath>
+#include <algorithm>
 
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <Xinput.h>
+namespace gp
+{
+	template <typename T>
+	constexpr double convert(const T tValue)
+	{
+		constexpr double dMinimum = static_cast<double>(std::numeric_limits<T>::min());
+		constexpr double dRange = static_cast<double>(std::numeric_limits<T>::max()) - dMinimum;
 
-#undef min
-#undef max
+		if constexpr (std::is_signed_v<T>)
+		{
+			return 2.0 * (static_cast<double>(tValue) - dMinimum) / dRange - 1.0;
+		}
+		else
+		{
+			return (static_cast<double>(tValue) - dMinimum) / dRange;
+		}
+	}
 
-#pragma comment(lib, "XInput.lib")
+	template <typename T>
+	T unconvert(const double dValue)
+	{
+		constexpr double dMinimum = static_cast<double>(std::numeric_limits<T>::min());
+		constexpr double dRange = static_cast<double>(std::numeric_limits<T>::max()) - dMinimum;
 
-namespace gp
-{
-	const XINPUT_STATE stateEmpty = {};
+		return static_cast<T>(std::clamp(std::round((dValue + 1.0) * dRange / 2.0 + dMinimum), dMinimum, dMinimum + dRange));
+	}
+
+	Normalized normalize(const State& state)
+	{
+		Normalized normalized;
+
+		normalized.dAxes[Axis::TriggerLeft] = convert(state.bLeftTrigger);
+		normalized.dAxes[Axis::TriggerRight] = convert(state.bRightTrigger);
+		normalized.dAxes[Axis::StickLeftX] = convert(state.sThumbLX);
+		normalized.dAxes[Axis::StickLeftY] = convert(state.sThumbLY);
+		normalized.dAxes[Axis::StickRightX] = convert(state.sThumbRX);
+		normalized.dAxes[Axis::StickRightY] = convert(state.sThumbRY);
 
-	void Button::update(const bool bPressed)
+		return normalized;
+	}
+
+	const State stateEmpty = {};
+
+	const Normalized normalizedEmpty = normalize(stateEmpty);
+
+	bool Button::update(const bool bPressed)
 	{
-		if (bPressed && !this->bPressed)
+		const bool bChanged = bPressed != this->bPressed;
+
+		this->bPressed = bPressed;
+
+		return bChanged;
+	}
+
+	double Axis::value(const double dValue) const
+	{
+		const double dDeadzoned = std::max(0.0, dValue - this->dThreshold) / (1.0 - this->dThreshold);
+
+		return this->dSpeed * dDeadzoned;
+	}
+
+	bool Axis::update(const double dValue)
+	{
+		const double dNormalized = (dValue - this->dReleaseThreshold) / (this->dPressThreshold - this->dReleaseThreshold);
+
+		if (dNormalized >= 1.0 && !this->bPressed)
 		{
-			if (this->fPress)
-			{
-				this->fPress();
-			}
+			this->bPressed = true;
+
+			return true;
 		}
-		else if (!bPressed && this->bPressed)
+		else if (dNormalized <= 0.0 && this->bPressed)
 		{
-			if (this->fRelease)
-			{
-				this->fRelease();
-			}
+			this->bPressed = false;
+
+			return true;
 		}
 
-		this->bPressed = bPressed;
+		return false;
 	}
 
-	void Axis::update(const double dValue)
+	Stick::Stick(const Action& action, const double dSpeed, const double dThreshold, const CurvePtr& pCurve, const Smoothing& smoothing, const mouse::Inertia& inertia) :
+		action(action), dSpeed(dSpeed), dThreshold(dThreshold), pCurve(pCurve),
+		iThreshold(static_cast<std::int32_t>(std::lround(std::clamp(dThreshold, 0.0, 1.0) * static_cast<double>(1 << Curve::One)))),
+		iInverse(static_cast<std::int32_t>(std::lround(65536.0 / std::max(1.0 - dThreshold, 1.0 / 256.0)))),
+		iSpeed(static_cast<std::int32_t>(std::lround(std::clamp(dSpeed, -32767.0, 32767.0) * 65536.0))),
+		filter(smoothing), momentum(inertia)
 	{
-		if (this->fCallback)
+
+	}
+
+	bool Stick::update(const double dValueX, const double dValueY, double& dOutputX, double& dOutputY) const
+	{
+		const double dLength = std::sqrt(dValueX * dValueX + dValueY * dValueY);
+		const double dDeadzonedLength = std::max(0.0, dLength - this->dThreshold);
+
+		if (dDeadzonedLength > 0.0)
 		{
-			const double dDeadzoned = std::max(0.0, dValue - this->dThreshold) / (1.0 - this->dThreshold);
+			const double dFactor = dDeadzonedLength / dLength / (1.0 - this->dThreshold);
+
+			dOutputX = this->dSpeed * dValueX * dFactor;
+			dOutputY = this->dSpeed * dValueY * dFactor;
 
-			this->fCallback(this->dSpeed * dDeadzoned);
+			this->shape(dDeadzonedLength, dOutputX, dOutputY);
+
+			return true;
 		}
-		else
+
+		return false;
+	}
+
+	void Stick::shape(const double dDeadzoned, double& dOutputX, double& dOutputY) const
+	{
+		if (!this->pCurve || dDeadzoned <= 0.0)
+		{
+			return;
+		}
+
+		// The linear output already carries the direction and the deflection, so one factor swaps the deflection for the curve.
+		const double dDeflection = dDeadzoned / (1.0 - this->dThreshold);
+
+		const double dFactor = (*this->pCurve)(dDeflection) / dDeflection;
+
+		dOutputX *= dFactor;
+		dOutputY *= dFactor;
+	}
+
+	void Gamepad::dispatch(const Action& action, const bool bPress)
+	{
+		switch (action.type)
+		{
+		case Action::MouseButton:
+		{
+			if (bPress)
+			{
+				mouse::press(static_cast<mouse::Button::Name>(action.uPress));
+			}
+			else
+			{
+				mouse::release(static_cast<mouse::Button::Name>(action.uPress));
+			}
+
+			break;
+		}
+		case Action::MouseScroll:
 		{
-			const double dNormalized = (dValue - this->dReleaseThreshold) / (this->dPressThreshold - this->dReleaseThreshold);
+			if (bPress)
+			{
+				mouse::scrollStep(static_cast<mouse::Scroll::Name>(action.uPress));
+			}
 
-			if (dNormalized >= 1.0 && !this->bPressed)
+			break;
+		}
+		case Action::Key:
+		{
+			if (bPress)
 			{
-				this->bPressed = true;
+				key::press(static_cast<key::Key::Name>(action.uPress));
+			}
+			else
+			{
+				key::release(static_cast<key::Key::Name>(action.uPress));
+			}
 
-				if (this->fPress)
+			break;
+		}
+		case Action::Event:
+		{
+			if (bPress)
+			{
+				switch (action.uPress)
 				{
-					this->fPress();
+				case Event::Enable:
+				{
+					this->enable();
+
+					break;
+				}
+				case Event::Disable:
+				{
+					this->disable();
+
+					break;
+				}
+				case Event::Toggle:
+				{
+					this->toggle();
+
+					break;
+				}
+				default:
+				{
+					break;
+				}
 				}
 			}
-			else if (dNormalized <= 0.0 && this->bPressed)
+
+			break;
+		}
+		case Action::Combination:
+		{
+			Combination& combination = this->vCombinations[action.uPress];
+
+			if (bPress)
 			{
-				this->bPressed = false;
+				combination.szCounter++;
 
-				if (this->fRelease)
+				if (combination.szCounter == combination.szCount)
+				{
+					this->dispatch(combination.action, true);
+				}
+			}
+			else
+			{
+				if (combination.szCounter == combination.szCount)
 				{
-					this->fRelease();
+					this->dispatch(combination.action, false);
 				}
+
+				combination.szCounter--;
+			}
+
+			break;
+		}
+		case Action::Function:
+		{
+			if (void(*fFunction)() = this->vFunctions[bPress ? action.uPress : action.uRelease])
+			{
+				fFunction();
+			}
+
+			break;
+		}
+		case Action::Callback:
+		{
+			if (const std::function<void()>& fCallback = this->vCallbacks[bPress ? action.uPress : action.uRelease])
+			{
+				fCallback();
+			}
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
+		}
+	}
+
+	void Gamepad::dispatch(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum, const double dValue)
+	{
+		switch (action.type)
+		{
+		case Action::MouseMotion:
+		{
+			this->dispatch(action, remainder, momentum, dValue, dValue);
+
+			break;
+		}
+		case Action::Function:
+		{
+			if (void(*fFunction)(const double) = this->vAxisFunctions[action.uPress])
+			{
+				fFunction(dValue);
 			}
+
+			break;
+		}
+		case Action::Callback:
+		{
+			this->vAxisCallbacks[action.uPress](dValue);
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
 		}
 	}
 
-	void Stick::update(const double dValueX, const double dValueY)
+	void Gamepad::dispatch(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum, const double dValueX, const double dValueY)
 	{
-		if (this->fCallback)
+		switch (action.type)
+		{
+		case Action::MouseMotion:
 		{
-			const double dLength = std::sqrt(dValueX * dValueX + dValueY * dValueY);
-			const double dDeadzonedLength = std::max(0.0, dLength - this->dThreshold);
+			const mouse::Motion::Name motion = static_cast<mouse::Motion::Name>(action.uPress);
+
+			if (this->bMomentum)
+			{
+				const output::Velocity velocity = mouse::channels(motion, dValueX, dValueY);
+
+				this->motionTick.dMoveX += velocity.dMoveX;
+				this->motionTick.dMoveY += velocity.dMoveY;
+				this->motionTick.dScrollX += velocity.dScrollX;
+				this->motionTick.dScrollY += velocity.dScrollY;
+			}
 
-			if (dDeadzonedLength > 0.0)
+			if (momentum.isEnabled())
+			{
+				// Bindings with momentum move once the input of every binding in this tick is known, see coast().
+				momentum.input(dValueX, dValueY);
+			}
+			else if (output::isGliding())
+			{
+				mouse::velocity(motion, dValueX, dValueY);
+			}
+			else
 			{
-				const double dFactor = dDeadzonedLength / dLength / (1.0 - this->dThreshold);
-				const double dDeadzonedX = dValueX * dFactor;
-				const double dDeadzonedY = dValueY * dFactor;
+				mouse::motion(motion, remainder, dValueX * this->dElapsed, dValueY * this->dElapsed);
+			}
 
-				this->fCallback(this->dSpeed * dDeadzonedX, this->dSpeed * dDeadzonedY);
+			break;
+		}
+		case Action::Function:
+		{
+			if (void(*fFunction)(const double, const double) = this->vStickFunctions[action.uPress])
+			{
+				fFunction(dValueX, dValueY);
 			}
+
+			break;
+		}
+		case Action::Callback:
+		{
+			this->vStickCallbacks[action.uPress](dValueX, dValueY);
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
+		}
+	}
+
+	void Gamepad::move(const Action& action, mouse::Remainder& remainder, const double dDistanceX, const double dDistanceY)
+	{
+		const mouse::Motion::Name motion = static_cast<mouse::Motion::Name>(action.uPress);
+
+		if (!output::isGliding())
+		{
+			mouse::motion(motion, remainder, dDistanceX, dDistanceY);
+		}
+		else if (this->dElapsed > 0.0)
+		{
+			mouse::velocity(motion, dDistanceX / this->dElapsed, dDistanceY / this->dElapsed);
 		}
 	}
 
-	Gamepad::Gamepad(const int iIndex, const bool bEnabled) :
-		iIndex(iIndex), bEnabled(bEnabled), tLast(std::chrono::steady_clock::now())
+	void Gamepad::coast(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum)
 	{
-		this->vButtons[false].resize(Button::Count);
-		this->vButtons[true].resize(Button::Count);
+		if (!momentum.isEnabled())
+		{
+			return;
+		}
 
-		this->vAxes[false].resize(Axis::Count);
-		this->vAxes[true].resize(Axis::Count);
+		const output::Velocity velocity = mouse::channels(static_cast<mouse::Motion::Name>(action.uPress), momentum.x(), momentum.y());
+
+		if (velocity.dMoveX * this->motionTick.dMoveX < 0.0 || velocity.dMoveY * this->motionTick.dMoveY < 0.0 || velocity.dScrollX * this->motionTick.dScrollX < 0.0 || velocity.dScrollY * this->motionTick.dScrollY < 0.0)
+		{
+			momentum.stop();
+		}
+
+		double dDistanceX = 0.0;
+		double dDistanceY = 0.0;
+
+		momentum.advance(dDistanceX, dDistanceY, this->dElapsed);
+
+		if (momentum.isMoving() || dDistanceX != 0.0 || dDistanceY != 0.0)
+		{
+			this->move(action, remainder, dDistanceX, dDistanceY);
+
+			this->bActive = true;
+		}
+	}
+
+	void Gamepad::bindButton(const bool alwaysEnabled, const Button::Name button, const Action& action)
+	{
+		if (button < Button::Count)
+		{
+			this->buttons[!alwaysEnabled].insert(button, Button(action));
+		}
+	}
+
+	void Gamepad::bindAxis(const bool alwaysEnabled, const Axis::Name axis, const Action& action, const bool bContinuous, const double dFirst, const double dSecond, const mouse::Inertia& inertia)
+	{
+		if (axis < Axis::Count)
+		{
+			this->axes[!alwaysEnabled].insert(axis, Axis(action, bContinuous, dFirst, dSecond, inertia));
+
+			this->bMomentum |= inertia.dFriction > 0.0;
+		}
+	}
+
+	void Gamepad::bindStick(const bool alwaysEnabled, const Stick::Name stick, const Action& action, const double dSpeed, const double dThreshold, const CurvePtr& pCurve, const Smoothing& smoothing, const mouse::Inertia& inertia)
+	{
+		if (stick >= 0 && stick < Stick::Count)
+		{
+			this->sticks[!alwaysEnabled].insert(stick, Stick(action, dSpeed, dThreshold, pCurve, smoothing, inertia));
+
+			this->bMomentum |= inertia.dFriction > 0.0;
+		}
+	}
+
+	void Gamepad::smooth(const State& state)
+	{
+		for (int i = false; i <= true; i++)
+		{
+			for (int iStick = 0; iStick < Stick::Count; iStick++)
+			{
+				const std::int16_t sX = iStick == Stick::Left ? state.sThumbLX : state.sThumbRX;
+				const std::int16_t sY = iStick == Stick::Left ? state.sThumbLY : state.sThumbRY;
+
+				for (Stick& stick : this->sticks[i][iStick])
+				{
+					if (!stick.filter.isEnabled())
+					{
+						continue;
+					}
+
+					if (!this->bConnected)
+					{
+						stick.filter.reset();
+
+						stick.sFilteredX = 0;
+						stick.sFilteredY = 0;
+
+						continue;
+					}
+
+					double dX = convert(sX);
+					double dY = convert(sY);
+
+					stick.filter.filter(dX, dY, this->dElapsed);
+
+					stick.sFilteredX = unconvert<std::int16_t>(dX);
+					stick.sFilteredY = unconvert<std::int16_t>(dY);
+				}
+			}
+		}
+	}
+
+	Gamepad::Gamepad(const int iIndex, const bool bEnabled, const BackendPtr& pBackend) :
+		iIndex(iIndex), pBackend(pBackend), bEnabled(bEnabled), tLast((pBackend ? pBackend->now() : std::chrono::steady_clock::now()) - std::chrono::milliseconds(250))
+	{
 
-		this->vSticks[false].resize(Stick::Count);
-		this->vSticks[true].resize(Stick::Count);
 	}
 
 	Gamepad::~Gamepad()
@@ -131,136 +486,320 @@ namespace gp
 
 	void Gamepad::update()
 	{
-		std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+		State state;
 
-		if (!this->bConnected && std::chrono::duration_cast<std::chrono::milliseconds>(tNow - this->tLast).count() < 250)
+		if (this->poll(state))
 		{
-			return;
+			this->process(state, normalize(state));
 		}
+	}
 
-		this->tLast = tNow;
+	bool Gamepad::poll(State& state)
+	{
+		std::chrono::steady_clock::time_point tNow = this->pBackend ? this->pBackend->now() : std::chrono::steady_clock::now();
 
-		XINPUT_STATE state;
+		if (!this->bConnected && !(this->pBackend && this->pBackend->isPaced()) && std::chrono::duration_cast<std::chrono::milliseconds>(tNow - this->tLast).count() < 250)
+		{
+			return false;
+		}
 
-		const XINPUT_STATE* states[2] = {
-			&state,
-			&stateEmpty
-		};
+		this->tLast = tNow;
 
-		if (XInputGetState(static_cast<DWORD>(this->iIndex), &state) == ERROR_DEVICE_NOT_CONNECTED)
+		if (!this->pBackend || !this->pBackend->read(this->iIndex, state))
 		{
 			if (!this->bConnected)
 			{
-				return;
+				return false;
 			}
 
 			this->bConnected = false;
 
-			states[0] = states[1];
+			state = stateEmpty;
 		}
 		else
 		{
+			const std::chrono::steady_clock::time_point tSample = std::chrono::steady_clock::now();
+
+			if (this->bConnected)
+			{
+				this->intervalHistogram.record(tSample - this->tSample);
+			}
+
+			// A stalled pad moves at most a tenth of a second worth of motion instead of jumping.
+			this->dElapsed = this->bConnected ? std::min(std::chrono::duration<double>(tNow - this->tMotion).count(), 0.1) : 0.0;
+
+			this->tMotion = tNow;
+
+			this->tSample = tSample;
+
 			this->bConnected = true;
 		}
 
-		if (this->bEnabled)
-		{
-			states[1] = states[0];
-		}
+		this->smooth(state);
+
+		return true;
+	}
 
-		const WORD wButtonMaskMap[] = {
-			XINPUT_GAMEPAD_DPAD_UP,
-			XINPUT_GAMEPAD_DPAD_DOWN,
-			XINPUT_GAMEPAD_DPAD_LEFT,
-			XINPUT_GAMEPAD_DPAD_RIGHT,
-			XINPUT_GAMEPAD_START,
-			XINPUT_GAMEPAD_BACK,
-			XINPUT_GAMEPAD_LEFT_THUMB,
-			XINPUT_GAMEPAD_RIGHT_THUMB,
-			XINPUT_GAMEPAD_LEFT_SHOULDER,
-			XINPUT_GAMEPAD_RIGHT_SHOULDER,
-			XINPUT_GAMEPAD_A,
-			XINPUT_GAMEPAD_B,
-			XINPUT_GAMEPAD_X,
-			XINPUT_GAMEPAD_Y
+	std::size_t Gamepad::lanes() const
+	{
+		return this->sticks[false].size() + this->sticks[true].size();
+	}
+
+	void Gamepad::lanes(const State& state, std::int16_t* pX, std::int16_t* pY, double* pThreshold, double* pSpeed) const
+	{
+		const State* states[2] = {
+			&state,
+			this->bEnabled ? &state : &stateEmpty
 		};
 
-		for (int i = false; i <= (this->bEnabled ? 1 : 0); i++)
+		std::size_t szLane = 0;
+
+		for (int i = false; i <= true; i++)
 		{
-			for (int iButton = 0; iButton < Button::Count; iButton++)
+			for (int iStick = 0; iStick < Stick::Count; iStick++)
 			{
-				const bool bPressed = static_cast<bool>(states[i]->Gamepad.wButtons & wButtonMaskMap[iButton]);
+				const std::int16_t sX = iStick == Stick::Left ? states[i]->sThumbLX : states[i]->sThumbRX;
+				const std::int16_t sY = iStick == Stick::Left ? states[i]->sThumbLY : states[i]->sThumbRY;
 
-				for (Button& button : this->vButtons[i][iButton])
+				for (const Stick& stick : this->sticks[i][iStick])
 				{
-					button.update(bPressed);
+					const bool bFiltered = states[i] == &state && stick.filter.isEnabled();
+
+					pX[szLane] = bFiltered ? stick.sFilteredX : sX;
+					pY[szLane] = bFiltered ? stick.sFilteredY : sY;
+					pThreshold[szLane] = stick.dThreshold;
+					pSpeed[szLane] = stick.dSpeed;
+
+					szLane++;
 				}
 			}
 		}
+	}
+
+	void Gamepad::lanes(const State& state, std::int16_t* pX, std::int16_t* pY, std::int32_t* pThreshold, std::int32_t* pInverse, std::int32_t* pSpeed, const Curve** pCurves) const
+	{
+		const State* states[2] = {
+			&state,
+			this->bEnabled ? &state : &stateEmpty
+		};
+
+		std::size_t szLane = 0;
 
-		auto fConversionCreator = []<typename T>(const T& tValue) -> std::function<double()>
+		for (int i = false; i <= true; i++)
 		{
-			if (std::is_signed_v<T>)
-			{
-				return [&]()
-				{
-					return 2.0 * (static_cast<double>(tValue) - static_cast<double>(std::numeric_limits<T>::min())) / (static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(std::numeric_limits<T>::min())) - 1.0;
-				};
-			}
-			else
+			for (int iStick = 0; iStick < Stick::Count; iStick++)
 			{
-				return [&]()
+				const std::int16_t sX = iStick == Stick::Left ? states[i]->sThumbLX : states[i]->sThumbRX;
+				const std::int16_t sY = iStick == Stick::Left ? states[i]->sThumbLY : states[i]->sThumbRY;
+
+				for (const Stick& stick : this->sticks[i][iStick])
 				{
-					return (static_cast<double>(tValue) - static_cast<double>(std::numeric_limits<T>::min())) / (static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(std::numeric_limits<T>::min()));
-				};
+					const bool bFiltered = states[i] == &state && stick.filter.isEnabled();
+
+					pX[szLane] = bFiltered ? stick.sFilteredX : sX;
+					pY[szLane] = bFiltered ? stick.sFilteredY : sY;
+					pThreshold[szLane] = stick.iThreshold;
+					pInverse[szLane] = stick.iInverse;
+					pSpeed[szLane] = stick.iSpeed;
+					pCurves[szLane] = stick.pCurve.get();
+
+					szLane++;
+				}
 			}
+		}
+	}
+
+	void Gamepad::process(const State& state, const Normalized& normalizedState, const Lanes* pLanes)
+	{
+		const State* states[2] = {
+			&state,
+			&stateEmpty
 		};
 
-		const std::function<double()> fAxisConversionMap[2][6] = {
-			{
-				fConversionCreator(states[false]->Gamepad.bLeftTrigger),
-				fConversionCreator(states[false]->Gamepad.bRightTrigger),
-				fConversionCreator(states[false]->Gamepad.sThumbLX),
-				fConversionCreator(states[false]->Gamepad.sThumbLY),
-				fConversionCreator(states[false]->Gamepad.sThumbRX),
-				fConversionCreator(states[false]->Gamepad.sThumbRY)
-			},
+		if (this->bEnabled)
+		{
+			states[1] = states[0];
+		}
+
+		this->bActive = states[0]->wButtons != 0;
+
+		output::source(&this->latencyHistogram, this->tSample);
+
+		for (int i = false; i <= (this->bEnabled ? 1 : 0); i++)
+		{
+			for (unsigned int uButton = 0; uButton < Button::Count; uButton++)
 			{
-				fConversionCreator(states[true]->Gamepad.bLeftTrigger),
-				fConversionCreator(states[true]->Gamepad.bRightTrigger),
-				fConversionCreator(states[true]->Gamepad.sThumbLX),
-				fConversionCreator(states[true]->Gamepad.sThumbLY),
-				fConversionCreator(states[true]->Gamepad.sThumbRX),
-				fConversionCreator(states[true]->Gamepad.sThumbRY)
+				const bool bPressed = static_cast<bool>(states[i]->wButtons & (1u << uButton));
+
+				for (Button& button : this->buttons[i][uButton])
+				{
+					if (button.update(bPressed))
+					{
+						this->dispatch(button.action, bPressed);
+					}
+				}
 			}
+		}
+
+		const Normalized* normalized[2] = {
+			&normalizedState,
+			states[true] == states[false] ? &normalizedState : &normalizedEmpty
 		};
 
 		for (int i = false; i <= (this->bEnabled ? 1 : 0); i++)
 		{
-			for (int iAxis = 0; iAxis < Axis::Count; iAxis++)
+			for (unsigned int uAxis = 0; uAxis < Axis::Count; uAxis++)
 			{
-				const double dValue = fAxisConversionMap[i][iAxis]();
+				const double dValue = normalized[i]->dAxes[uAxis];
 
-				for (Axis& axis : this->vAxes[i][iAxis])
+				for (Axis& axis : this->axes[i][uAxis])
 				{
-					axis.update(dValue);
+					if (axis.bContinuous)
+					{
+						const double dOutput = axis.value(dValue);
+
+						this->dispatch(axis.action, axis.remainder, axis.momentum, dOutput);
+
+						this->bActive |= dOutput != 0.0;
+					}
+					else
+					{
+						if (axis.update(dValue))
+						{
+							this->dispatch(axis.action, axis.bPressed);
+						}
+
+						this->bActive |= axis.bPressed;
+					}
 				}
 			}
 		}
 
+		std::size_t szLane = 0;
+
 		for (int i = false; i <= (this->bEnabled ? 1 : 0); i++)
 		{
 			for (int iStick = 0; iStick < Stick::Count; iStick++)
 			{
-				const double dValueX = iStick == Stick::Left ? fAxisConversionMap[i][Axis::StickLeftX]() : fAxisConversionMap[i][Axis::StickRightX]();
-				const double dValueY = iStick == Stick::Left ? fAxisConversionMap[i][Axis::StickLeftY]() : fAxisConversionMap[i][Axis::StickRightY]();
+				const double dValueX = normalized[i]->dAxes[iStick == Stick::Left ? Axis::StickLeftX : Axis::StickRightX];
+				const double dValueY = normalized[i]->dAxes[iStick == Stick::Left ? Axis::StickLeftY : Axis::StickRightY];
+
+				for (Stick& stick : this->sticks[i][iStick])
+				{
+					double dOutputX = 0.0;
+					double dOutputY = 0.0;
+
+					bool bOutside = false;
+
+					if (pLanes && pLanes->pFixedX)
+					{
+						dOutputX = static_cast<double>(pLanes->pFixedX[szLane]) / 65536.0;
+						dOutputY = static_cast<double>(pLanes->pFixedY[szLane]) / 65536.0;
+
+						bOutside = pLanes->pDeflection[szLane] > 0;
+					}
+					else if (pLanes)
+					{
+						dOutputX = pLanes->pOutputX[szLane];
+						dOutputY = pLanes->pOutputY[szLane];
+
+						bOutside = pLanes->pDeadzoned[szLane] > 0.0;
+
+						stick.shape(pLanes->pDeadzoned[szLane], dOutputX, dOutputY);
+					}
+					else if (normalized[i] == &normalizedState && stick.filter.isEnabled())
+					{
+						bOutside = stick.update(convert(stick.sFilteredX), convert(stick.sFilteredY), dOutputX, dOutputY);
+					}
+					else
+					{
+						bOutside = stick.update(dValueX, dValueY, dOutputX, dOutputY);
+					}
+
+					szLane++;
+
+					if (bOutside)
+					{
+						this->dispatch(stick.action, stick.remainder, stick.momentum, dOutputX, dOutputY);
+
+						this->bActive = true;
+					}
+				}
+			}
+		}
+
+		if (this->bMomentum)
+		{
+			for (int i = false; i <= (this->bEnabled ? 1 : 0); i++)
+			{
+				for (Axis& axis : this->axes[i].all())
+				{
+					this->coast(axis.action, axis.remainder, axis.momentum);
+				}
 
-				for (Stick& stick : this->vSticks[i][iStick])
+				for (Stick& stick : this->sticks[i].all())
 				{
-					stick.update(dValueX, dValueY);
+					this->coast(stick.action, stick.remainder, stick.momentum);
 				}
 			}
+
+			this->motionTick = output::Velocity();
+		}
+
+		output::source(nullptr, this->tSample);
+	}
+
+	void Gamepad::release()
+	{
+		const bool bEnabled = this->bEnabled;
+
+		this->bEnabled = true;
+
+		this->process(stateEmpty, normalizedEmpty);
+
+		this->bEnabled = bEnabled;
+	}
+
+	void Gamepad::adopt(const Gamepad& layout)
+	{
+		this->release();
+
+		for (int i = false; i <= true; i++)
+		{
+			this->buttons[i] = layout.buttons[i];
+			this->axes[i] = layout.axes[i];
+			this->sticks[i] = layout.sticks[i];
 		}
+
+		this->vCombinations = layout.vCombinations;
+
+		this->vFunctions = layout.vFunctions;
+		this->vCallbacks = layout.vCallbacks;
+
+		this->vAxisFunctions = layout.vAxisFunctions;
+		this->vAxisCallbacks = layout.vAxisCallbacks;
+
+		this->vStickFunctions = layout.vStickFunctions;
+		this->vStickCallbacks = layout.vStickCallbacks;
+
+		this->bMomentum = layout.bMomentum;
+
+		this->motionTick = output::Velocity();
+	}
+
+	const stats::Histogram& Gamepad::latency() const
+	{
+		return this->latencyHistogram;
+	}
+
+	const stats::Histogram& Gamepad::interval() const
+	{
+		return this->intervalHistogram;
+	}
+
+	int Gamepad::index() const
+	{
+		return this->iIndex;
 	}
 
 	bool Gamepad::isConnected() const
@@ -292,15 +831,20 @@ namespace gp
 	{
 		return this->isConnected() && this->isEnabled();
 	}
+
+	bool Gamepad::isActive() const
+	{
+		return this->bActive;
+	}
 	
-	GamepadPtr make(const int iIndex, const bool bEnabled)
+	GamepadPtr make(const int iIndex, const bool bEnabled, const BackendPtr& pBackend)
 	{
-		return std::make_shared<Gamepad>(iIndex, bEnabled);
+		return std::make_shared<Gamepad>(iIndex, bEnabled, pBackend);
 	}
 
-	GamepadPtr makeDefault(const int iIndex, const bool bEnabled)
+	GamepadPtr makeDefault(const int iIndex, const bool bEnabled, const BackendPtr& pBackend)
 	{
-		GamepadPtr gamepad = make(iIndex, bEnabled);
+		GamepadPtr gamepad = make(iIndex, bEnabled, pBackend);
 
 		gamepad->button(Button::A, mouse::Button::Left);
 		gamepad->button(Button::B, mouse::Button::Right);
@@ -315,11 +859,11 @@ namespace gp
 		gamepad->button(Button::ShoulderLeft, key::switchWindows);
 		gamepad->button(Button::ShoulderRight, key::takeScreenshot);
 
-		gamepad->axis(Axis::TriggerLeft, mouse::scrollY, 10.0);
-		gamepad->axis(Axis::TriggerRight, mouse::scrollY, -10.0);
+		gamepad->axis(Axis::TriggerLeft, mouse::Motion::ScrollY, 1000.0);
+		gamepad->axis(Axis::TriggerRight, mouse::Motion::ScrollY, -1000.0);
 
-		gamepad->stick(Stick::Left, mouse::move, 10.0);
-		gamepad->stick(Stick::Right, mouse::scroll, 10.0);
+		gamepad->stick(Stick::Left, mouse::Motion::Move, 1000.0);
+		gamepad->stick(Stick::Right, mouse::Motion::Scroll, 1000.0);
 
 		gamepad->combination<true>(Button::Back, Button::Start, Gamepad::Event::Toggle);
 
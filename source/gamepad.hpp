@@ -25,18 +25,31 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <vector>
 #include <chrono>
 #include <memory>
+#include <type_traits>
 
 #include "mouse.hpp"
 #include "keyboard.hpp"
+#include "backend.hpp"
+#include "action.hpp"
+#include "curve.hpp"
+#include "filter.hpp"
+#include "momentum.hpp"
+#include "stats.hpp"
 
 namespace gp
 {
 	class Gamepad;
 
+	namespace profile
+	{
+		class Profile;
+	}
+
 	class Button
 	{
 	public:
@@ -62,19 +75,17 @@ namespace gp
 		} Name;
 
 	private:
-		bool bPressed = false;
+		Action action;
 
-		std::function<void()> fPress = nullptr;
-		std::function<void()> fRelease = nullptr;
+		bool bPressed = false;
 
-		template <typename FPress, typename FRelease>
-		Button(FPress fPress, FRelease fRelease) :
-			fPress(fPress), fRelease(fRelease)
+		Button(const Action& action) :
+			action(action)
 		{
 
 		}
 
-		void update(const bool bPressed);
+		bool update(const bool bPressed);
 	};
 
 	class Axis
@@ -94,6 +105,9 @@ namespace gp
 		} Name;
 
 	private:
+		Action action;
+
+		bool bContinuous = false;
 		bool bPressed = false;
 
 		union
@@ -111,27 +125,38 @@ namespace gp
 			};
 		};
 
-		std::function<void()> fPress = nullptr;
-		std::function<void()> fRelease = nullptr;
+		mouse::Remainder remainder;
 
-		std::function<void(const double)> fCallback = nullptr;
-		
+		mouse::Momentum momentum;
 
-		template <typename FCallback>
-		Axis(FCallback fCallback, const double dSpeed, const double dThreshold) :
-			fCallback(fCallback), dSpeed(dSpeed), dThreshold(dThreshold)
+		Axis(const Action& action, const bool bContinuous, const double dFirst, const double dSecond, const mouse::Inertia& inertia) :
+			action(action), bContinuous(bContinuous), dPressThreshold(dFirst), dReleaseThreshold(dSecond), momentum(inertia)
 		{
 
 		}
 
-		template <typename FPress, typename FRelease>
-		Axis(FPress fPress, FRelease fRelease, const double dPressThreshold, const double dReleaseThreshold) :
-			fPress(fPress), fRelease(fRelease), dPressThreshold(dPressThreshold), dReleaseThreshold(dReleaseThreshold)
-		{
+		double value(const double dValue) const;
 
-		}
+		bool update(const double dValue);
+	};
 
-		void update(const double dValue);
+	struct Normalized
+	{
+		double dAxes[Axis::Count] = {};
+	};
+
+	extern Normalized normalize(const State& state);
+
+	struct Lanes
+	{
+		const double* pOutputX = nullptr;
+		const double* pOutputY = nullptr;
+		const double* pDeadzoned = nullptr;
+
+		// Fixed point lanes carry outputs with 16 fraction bits that already went through the curve.
+		const std::int32_t* pFixedX = nullptr;
+		const std::int32_t* pFixedY = nullptr;
+		const std::int32_t* pDeflection = nullptr;
 	};
 
 	class Stick
@@ -147,24 +172,42 @@ namespace gp
 		} Name;
 
 	private:
-		std::function<void(const double, const double)> fCallback = nullptr;
+		Action action;
 
 		double dSpeed = 1.0;
 		double dThreshold = 0.0;
 
-		template <typename FCallback>
-		Stick(FCallback fCallback, const double dSpeed, const double dThreshold) :
-			fCallback(fCallback), dSpeed(dSpeed), dThreshold(dThreshold)
-		{
+		// Without a curve the output grows linearly with the deflection outside the deadzone.
+		CurvePtr pCurve;
 
-		}
+		// Threshold, 1 / (1 - threshold) and speed for the fixed point pipeline, with Curve::One, 16 and 16 fraction bits.
+		std::int32_t iThreshold = 0;
+		std::int32_t iInverse = 0;
+		std::int32_t iSpeed = 0;
+
+		// Smoothing runs on the raw position before the deadzone, the filtered position is kept in thumb units for the lanes.
+		OneEuro filter;
+
+		std::int16_t sFilteredX = 0;
+		std::int16_t sFilteredY = 0;
+
+		mouse::Remainder remainder;
+
+		mouse::Momentum momentum;
 
-		void update(const double dValueX, const double dValueY);
+		Stick(const Action& action, const double dSpeed, const double dThreshold, const CurvePtr& pCurve, const Smoothing& smoothing, const mouse::Inertia& inertia);
+
+		bool update(const double dValueX, const double dValueY, double& dOutputX, double& dOutputY) const;
+
+		// Rescales linear outputs to the curve, dDeadzoned is the deflection length beyond the threshold.
+		void shape(const double dDeadzoned, double& dOutputX, double& dOutputY) const;
 	};
 
 	class Gamepad
 	{
 	public:
+		friend class profile::Profile;
+
 		struct Event
 		{
 			typedef enum : int
@@ -177,19 +220,164 @@ namespace gp
 		};
 
 	private:
+		struct Combination
+		{
+			Action action;
+
+			std::size_t szCounter = 0;
+			std::size_t szCount = 0;
+		};
+
 		int iIndex = 0;
 
+		BackendPtr pBackend = nullptr;
+
 		bool bConnected = false;
 		bool bEnabled = true;
+		bool bActive = false;
 
-		std::vector<std::vector<Button>> vButtons[2];
-		std::vector<std::vector<Axis>> vAxes[2];
-		std::vector<std::vector<Stick>> vSticks[2];
+		Bindings<Button, Button::Count> buttons[2];
+		Bindings<Axis, Axis::Count> axes[2];
+		Bindings<Stick, Stick::Count> sticks[2];
+
+		std::vector<Combination> vCombinations;
+
+		std::vector<void(*)()> vFunctions;
+		std::vector<std::function<void()>> vCallbacks;
+
+		std::vector<void(*)(const double)> vAxisFunctions;
+		std::vector<std::function<void(const double)>> vAxisCallbacks;
+
+		std::vector<void(*)(const double, const double)> vStickFunctions;
+		std::vector<std::function<void(const double, const double)>> vStickCallbacks;
 
 		std::chrono::steady_clock::time_point tLast;
 
+		std::chrono::steady_clock::time_point tSample;
+
+		// Seconds between the last two samples on the backend clock, mouse motion bindings integrate their speed over it.
+		std::chrono::steady_clock::time_point tMotion;
+
+		double dElapsed = 0.0;
+
+		// Speed every motion binding asked for in this tick, bindings with momentum stop when another one pushes against them.
+		bool bMomentum = false;
+
+		output::Velocity motionTick;
+
+		stats::Histogram latencyHistogram;
+		stats::Histogram intervalHistogram;
+
+		template <typename F, typename TFunction, typename TCallback>
+		static std::uint32_t store(std::vector<TFunction>& vFunctions, std::vector<TCallback>& vCallbacks, F f, bool& bFunction)
+		{
+			if constexpr (std::is_convertible_v<F, TFunction>)
+			{
+				bFunction = true;
+
+				vFunctions.push_back(static_cast<TFunction>(f));
+
+				return static_cast<std::uint32_t>(vFunctions.size() - 1);
+			}
+			else
+			{
+				bFunction = false;
+
+				vCallbacks.push_back(TCallback(f));
+
+				return static_cast<std::uint32_t>(vCallbacks.size() - 1);
+			}
+		}
+
+		template <typename FPress, typename FRelease>
+		Action makeAction(FPress fPress, FRelease fRelease)
+		{
+			if constexpr (std::is_convertible_v<FPress, void(*)()> && std::is_convertible_v<FRelease, void(*)()>)
+			{
+				this->vFunctions.push_back(static_cast<void(*)()>(fPress));
+				this->vFunctions.push_back(static_cast<void(*)()>(fRelease));
+
+				return { Action::Function, static_cast<std::uint32_t>(this->vFunctions.size() - 2), static_cast<std::uint32_t>(this->vFunctions.size() - 1) };
+			}
+			else
+			{
+				this->vCallbacks.push_back(std::function<void()>(fPress));
+				this->vCallbacks.push_back(std::function<void()>(fRelease));
+
+				return { Action::Callback, static_cast<std::uint32_t>(this->vCallbacks.size() - 2), static_cast<std::uint32_t>(this->vCallbacks.size() - 1) };
+			}
+		}
+
+		Action makeAction(const mouse::Button::Name mouseButton)
+		{
+			return { Action::MouseButton, static_cast<std::uint32_t>(mouseButton), 0 };
+		}
+
+		Action makeAction(const mouse::Scroll::Name mouseScroll)
+		{
+			return { Action::MouseScroll, static_cast<std::uint32_t>(mouseScroll), 0 };
+		}
+
+		Action makeAction(const mouse::Motion::Name mouseMotion)
+		{
+			return { Action::MouseMotion, static_cast<std::uint32_t>(mouseMotion), 0 };
+		}
+
+		Action makeAction(const key::Key::Name key)
+		{
+			return { Action::Key, static_cast<std::uint32_t>(key), 0 };
+		}
+
+		Action makeAction(const Event::Name event)
+		{
+			if (event < Event::Count)
+			{
+				return { Action::Event, static_cast<std::uint32_t>(event), 0 };
+			}
+
+			return {};
+		}
+
+		template <typename FCallback>
+		Action makeAxisAction(FCallback fCallback)
+		{
+			bool bFunction = false;
+
+			const std::uint32_t uIndex = store(this->vAxisFunctions, this->vAxisCallbacks, fCallback, bFunction);
+
+			return { bFunction ? Action::Function : Action::Callback, uIndex, 0 };
+		}
+
+		template <typename FCallback>
+		Action makeStickAction(FCallback fCallback)
+		{
+			bool bFunction = false;
+
+			const std::uint32_t uIndex = store(this->vStickFunctions, this->vStickCallbacks, fCallback, bFunction);
+
+			return { bFunction ? Action::Function : Action::Callback, uIndex, 0 };
+		}
+
+		void dispatch(const Action& action, const bool bPress);
+
+		void dispatch(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum, const double dValue);
+
+		void dispatch(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum, const double dValueX, const double dValueY);
+
+		void move(const Action& action, mouse::Remainder& remainder, const double dDistanceX, const double dDistanceY);
+
+		void coast(const Action& action, mouse::Remainder& remainder, mouse::Momentum& momentum);
+
+		void bindButton(const bool alwaysEnabled, const Button::Name button, const Action& action);
+
+		void bindAxis(const bool alwaysEnabled, const Axis::Name axis, const Action& action, const bool bContinuous, const double dFirst, const double dSecond, const mouse::Inertia& inertia = mouse::Inertia());
+
+		void bindStick(const bool alwaysEnabled, const Stick::Name stick, const Action& action, const double dSpeed, const double dThreshold, const CurvePtr& pCurve, const Smoothing& smoothing, const mouse::Inertia& inertia);
+
+		void smooth(const State& state);
+
 	public:
-		Gamepad(const int iIndex = 0, const bool bEnabled = true);
+		Gamepad(const int iIndex = 0, const bool bEnabled = true, const BackendPtr& pBackend = defaultBackend());
 
 		~Gamepad();
 
@@ -201,300 +389,215 @@ namespace gp
 
 		void update();
 
-		template <const bool alwaysEnabled = false, typename FPress = std::function<void()>, typename FRelease = std::function<void()>>
+		bool poll(State& state);
+
+		std::size_t lanes() const;
+
+		void lanes(const State& state, std::int16_t* pX, std::int16_t* pY, double* pThreshold, double* pSpeed) const;
+
+		void lanes(const State& state, std::int16_t* pX, std::int16_t* pY, std::int32_t* pThreshold, std::int32_t* pInverse, std::int32_t* pSpeed, const Curve** pCurves) const;
+
+		void process(const State& state, const Normalized& normalized, const Lanes* pLanes = nullptr);
+
+		// Releases every button, key and axis the pad holds as if it had been let go, enabled or not.
+		void release();
+
+		// Releases what the pad holds and copies the bindings of layout, connection, clock and statistics stay.
+		void adopt(const Gamepad& layout);
+
+		template <const bool alwaysEnabled = false, typename FPress = void(*)(), typename FRelease = void(*)()>
 		requires(std::is_constructible_v<std::function<void()>, FPress> && std::is_constructible_v<std::function<void()>, FRelease>)
 		void button(const Button::Name button, FPress fPress = [] {}, FRelease fRelease = [] {})
 		{
-			if (button < Button::Count)
-			{
-				this->vButtons[!alwaysEnabled][button].push_back(Button(fPress, fRelease));
-			}
+			this->bindButton(alwaysEnabled, button, this->makeAction(fPress, fRelease));
 		}
 
 		template <const bool alwaysEnabled = false>
 		void button(const Button::Name button, const mouse::Button::Name mouseButton)
 		{
-			this->button<alwaysEnabled>(button, [mouseButton]() { mouse::press(mouseButton); }, [mouseButton]() { mouse::release(mouseButton); });
+			this->bindButton(alwaysEnabled, button, this->makeAction(mouseButton));
 		}
 
 		template <const bool alwaysEnabled = false>
 		void button(const Button::Name button, const mouse::Scroll::Name mouseScroll)
 		{
-			this->button<alwaysEnabled>(button, [mouseScroll]() { mouse::scrollStep(mouseScroll); }, [] {});
+			this->bindButton(alwaysEnabled, button, this->makeAction(mouseScroll));
 		}
 
 		template <const bool alwaysEnabled = false>
 		void button(const Button::Name button, const key::Key::Name key)
 		{
-			this->button<alwaysEnabled>(button, [key]() { key::press(key); }, [key]() { key::release(key); });
+			this->bindButton(alwaysEnabled, button, this->makeAction(key));
 		}
 
 		template <const bool alwaysEnabled = false>
 		void button(const Button::Name button, const Event::Name event)
 		{
-			switch (event)
-			{
-			case Event::Enable:
-			{
-				return this->button<alwaysEnabled>(button, [this]() { this->enable(); }, [] { });
-			}
-			case Event::Disable:
-			{
-				return this->button<alwaysEnabled>(button, [this]() { this->disable(); }, [] {});
-			}
-			case Event::Toggle:
-			{
-				return this->button<alwaysEnabled>(button, [this]() { this->toggle(); }, [] {});
-			}
-			default:
-			{
-				break;
-			}
-			}
+			this->bindButton(alwaysEnabled, button, this->makeAction(event));
 		}
 
-		template <const bool alwaysEnabled = false, typename FCallback = std::function<void()>>
+		template <const bool alwaysEnabled = false, typename FCallback = void(*)(const double)>
 		requires(std::is_constructible_v<std::function<void(const double)>, FCallback>)
 		void axis(const Axis::Name axis, FCallback fCallback = [](const double) {}, const double dSpeed = 1.0, const double dThreshold = 0.25)
 		{
-			if (axis < Axis::Count)
-			{
-				this->vAxes[!alwaysEnabled][axis].push_back(Axis(fCallback, dSpeed, dThreshold));
-			}
+			this->bindAxis(alwaysEnabled, axis, this->makeAxisAction(fCallback), true, dSpeed, dThreshold);
 		}
 
-		template <const bool alwaysEnabled = false, typename FPress = std::function<void()>, typename FRelease = std::function<void()>>
+		// Speed is in pixels or scroll units per second at full deflection, so motion does not depend on the poll rate.
+		template <const bool alwaysEnabled = false>
+		void axis(const Axis::Name axis, const mouse::Motion::Name mouseMotion, const double dSpeed, const double dThreshold = 0.25, const mouse::Inertia& inertia = mouse::Inertia())
+		{
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(mouseMotion), true, dSpeed, dThreshold, inertia);
+		}
+
+		template <const bool alwaysEnabled = false, typename FPress = void(*)(), typename FRelease = void(*)()>
 		requires(std::is_constructible_v<std::function<void()>, FPress> && std::is_constructible_v<std::function<void()>, FRelease>)
 		void axisButton(const Axis::Name axis, FPress fPress = [] {}, FRelease fRelease = [] {}, const double dPressThreshold = 0.5, const double dReleaseThreshold = 0.25)
 		{
-			if (axis < Axis::Count)
-			{
-				this->vAxes[!alwaysEnabled][axis].push_back(Axis(fPress, fRelease, dPressThreshold, dReleaseThreshold));
-			}
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(fPress, fRelease), false, dPressThreshold, dReleaseThreshold);
 		}
 
 		template <const bool alwaysEnabled = false>
 		void axisButton(const Axis::Name axis, const mouse::Button::Name mouseButton, const double dPressThreshold = 0.5, const double dReleaseThreshold = 0.25)
 		{
-			this->axisButton<alwaysEnabled>(axis, [mouseButton]() { mouse::press(mouseButton); }, [mouseButton]() { mouse::release(mouseButton); }, dPressThreshold, dReleaseThreshold);
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(mouseButton), false, dPressThreshold, dReleaseThreshold);
 		}
 
 		template <const bool alwaysEnabled = false>
 		void axisButton(const Axis::Name axis, const mouse::Scroll::Name mouseScroll, const double dPressThreshold = 0.5, const double dReleaseThreshold = 0.25)
 		{
-			this->axisButton<alwaysEnabled>(axis, [mouseScroll]() { mouse::scrollStep(mouseScroll); }, [] {}, dPressThreshold, dReleaseThreshold);
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(mouseScroll), false, dPressThreshold, dReleaseThreshold);
 		}
 
 		template <const bool alwaysEnabled = false>
 		void axisButton(const Axis::Name axis, const key::Key::Name key, const double dPressThreshold = 0.5, const double dReleaseThreshold = 0.25)
 		{
-			this->axisButton<alwaysEnabled>(axis, [key]() { key::press(key); }, [key]() { key::release(key); }, dPressThreshold, dReleaseThreshold);
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(key), false, dPressThreshold, dReleaseThreshold);
 		}
 
 		template <const bool alwaysEnabled = false>
 		void axisButton(const Axis::Name axis, const Event::Name event, const double dPressThreshold = 0.5, const double dReleaseThreshold = 0.25)
 		{
-			switch (event)
-			{
-			case Event::Enable:
-			{
-				return this->axisButton<alwaysEnabled>(button, [this]() { this->enable(); }, [] {}, dPressThreshold, dReleaseThreshold);
-			}
-			case Event::Disable:
-			{
-				return this->axisButton<alwaysEnabled>(button, [this]() { this->disable(); }, [] {}, dPressThreshold, dReleaseThreshold);
-			}
-			case Event::Toggle:
-			{
-				return this->axisButton<alwaysEnabled>(button, [this]() { this->toggle(); }, [] {}, dPressThreshold, dReleaseThreshold);
-			}
-			default:
-			{
-				break;
-			}
-			}
+			this->bindAxis(alwaysEnabled, axis, this->makeAction(event), false, dPressThreshold, dReleaseThreshold);
 		}
 
-		template <const bool alwaysEnabled = false, typename FCallback = std::function<void()>>
+		template <const bool alwaysEnabled = false, typename FCallback = void(*)(const double, const double)>
 		requires(std::is_constructible_v<std::function<void(const double, const double)>, FCallback>)
-		void stick(const Stick::Name stick, FCallback fCallback = [](const double, const double) {}, const double dSpeed = 1.0, const double dThreshold = 0.25)
+		void stick(const Stick::Name stick, FCallback fCallback = [](const double, const double) {}, const double dSpeed = 1.0, const double dThreshold = 0.25, const CurvePtr& pCurve = nullptr, const Smoothing& smoothing = Smoothing())
 		{
-			if (stick < Stick::Count)
-			{
-				this->vSticks[!alwaysEnabled][stick].push_back(Stick(fCallback, dSpeed, dThreshold));
-			}
+			this->bindStick(alwaysEnabled, stick, this->makeStickAction(fCallback), dSpeed, dThreshold, pCurve, smoothing, mouse::Inertia());
 		}
 
-	private:
-		struct Combination
+		// Speed is in pixels or scroll units per second at full deflection, so motion does not depend on the poll rate.
+		template <const bool alwaysEnabled = false>
+		void stick(const Stick::Name stick, const mouse::Motion::Name mouseMotion, const double dSpeed, const double dThreshold = 0.25, const CurvePtr& pCurve = nullptr, const Smoothing& smoothing = Smoothing(), const mouse::Inertia& inertia = mouse::Inertia())
 		{
-			std::function<void()> fPress = nullptr;
-			std::function<void()> fRelease = nullptr;
-
-			std::size_t szCounter = 0;
-			std::size_t szCount = 0;
-		};
+			this->bindStick(alwaysEnabled, stick, this->makeAction(mouseMotion), dSpeed, dThreshold, pCurve, smoothing, inertia);
+		}
 
+	private:
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationSelector(const std::shared_ptr<Combination>& pCombination, const Button::Name button, Arguments&&... arguments)
+		void combinationSelector(const std::size_t szCombination, const Button::Name button, Arguments&&... arguments)
 		{
-			this->combinationButton<alwaysEnabled>(pCombination, button, std::forward<Arguments>(arguments)...);
+			this->combinationButton<alwaysEnabled>(szCombination, button, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationButton(const std::shared_ptr<Combination>& pCombination, const Button::Name button, Arguments&&... arguments)
+		void combinationButton(const std::size_t szCombination, const Button::Name button, Arguments&&... arguments)
 		{
-			pCombination->szCount++;
-
-			auto fPress = [pCombination]()
-			{
-				pCombination->szCounter++;
+			this->vCombinations[szCombination].szCount++;
 
-				if (pCombination->szCounter == pCombination->szCount)
-				{
-					pCombination->fPress();
-				}
-			};
-
-			auto fRelease = [pCombination]()
-			{
-				if (pCombination->szCounter == pCombination->szCount)
-				{
-					pCombination->fRelease();
-				}
-
-				pCombination->szCounter--;
-			};
-
-			this->button<alwaysEnabled>(button, fPress, fRelease);
+			this->bindButton(alwaysEnabled, button, { Action::Combination, static_cast<std::uint32_t>(szCombination), 0 });
 
-			this->combinationSelector<alwaysEnabled>(pCombination, std::forward<Arguments>(arguments)...);
+			this->combinationSelector<alwaysEnabled>(szCombination, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationSelector(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, Arguments&&... arguments)
+		void combinationSelector(const std::size_t szCombination, const Axis::Name axis, Arguments&&... arguments)
 		{
-			this->combinationAxisButton<alwaysEnabled>(pCombination, axis, std::forward<Arguments>(arguments)...);
+			this->combinationAxisButton<alwaysEnabled>(szCombination, axis, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationAxisButton(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, const double dPressThreshold, Arguments&&... arguments)
+		void combinationAxisButton(const std::size_t szCombination, const Axis::Name axis, const double dPressThreshold, Arguments&&... arguments)
 		{
-			this->combinationAxisButtonPressThreshold<alwaysEnabled>(pCombination, axis, dPressThreshold, std::forward<Arguments>(arguments)...);
+			this->combinationAxisButtonPressThreshold<alwaysEnabled>(szCombination, axis, dPressThreshold, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename Argument, typename... Arguments>
 		requires(!std::is_same_v<Argument, double>)
-		void combinationAxisButton(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, Argument&& argument, Arguments&&... arguments)
+		void combinationAxisButton(const std::size_t szCombination, const Axis::Name axis, Argument&& argument, Arguments&&... arguments)
 		{
-			this->combinationAxisButtonPressThreshold<alwaysEnabled>(pCombination, axis, 0.5, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
+			this->combinationAxisButtonPressThreshold<alwaysEnabled>(szCombination, axis, 0.5, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationAxisButtonPressThreshold(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, const double dPressThreshold, const double dReleaseThreshold, Arguments&&... arguments)
+		void combinationAxisButtonPressThreshold(const std::size_t szCombination, const Axis::Name axis, const double dPressThreshold, const double dReleaseThreshold, Arguments&&... arguments)
 		{
-			this->combinationAxisButtonPressThresholdReleaseThreshold<alwaysEnabled>(pCombination, axis, dPressThreshold, dReleaseThreshold, std::forward<Arguments>(arguments)...);
+			this->combinationAxisButtonPressThresholdReleaseThreshold<alwaysEnabled>(szCombination, axis, dPressThreshold, dReleaseThreshold, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename Argument, typename... Arguments>
 		requires(!std::is_same_v<Argument, double>)
-		void combinationAxisButtonPressThreshold(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, const double dPressThreshold, Argument&& argument, Arguments&&... arguments)
+		void combinationAxisButtonPressThreshold(const std::size_t szCombination, const Axis::Name axis, const double dPressThreshold, Argument&& argument, Arguments&&... arguments)
 		{
-			this->combinationAxisButtonPressThresholdReleaseThreshold<alwaysEnabled>(pCombination, axis, dPressThreshold, 0.25, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
+			this->combinationAxisButtonPressThresholdReleaseThreshold<alwaysEnabled>(szCombination, axis, dPressThreshold, 0.25, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename... Arguments>
-		void combinationAxisButtonPressThresholdReleaseThreshold(const std::shared_ptr<Combination>& pCombination, const Axis::Name axis, const double dPressThreshold, const double dReleaseThreshold, Arguments&&... arguments)
+		void combinationAxisButtonPressThresholdReleaseThreshold(const std::size_t szCombination, const Axis::Name axis, const double dPressThreshold, const double dReleaseThreshold, Arguments&&... arguments)
 		{
-			pCombination->szCount++;
-
-			auto fPress = [pCombination]()
-			{
-				pCombination->szCounter++;
-
-				if (pCombination->szCounter == pCombination->szCount)
-				{
-					pCombination->fPress();
-				}
-			};
-
-			auto fRelease = [pCombination]()
-			{
-				if (pCombination->szCounter == pCombination->szCount)
-				{
-					pCombination->fRelease();
-				}
-
-				pCombination->szCounter--;
-			};
+			this->vCombinations[szCombination].szCount++;
 
-			this->axisButton<alwaysEnabled>(axis, fPress, fRelease, dPressThreshold, dReleaseThreshold);
+			this->bindAxis(alwaysEnabled, axis, { Action::Combination, static_cast<std::uint32_t>(szCombination), 0 }, false, dPressThreshold, dReleaseThreshold);
 
-			this->combinationSelector<alwaysEnabled>(pCombination, std::forward<Arguments>(arguments)...);
+			this->combinationSelector<alwaysEnabled>(szCombination, std::forward<Arguments>(arguments)...);
 		}
 
 		template <const bool alwaysEnabled = false, typename Argument, typename... Arguments>
-		requires(!std::is_same_v<Argument, Button::Name> && !std::is_same_v<Argument, Axis::Name>)
-		void combinationSelector(const std::shared_ptr<Combination>& pCombination, Argument&& argument, Arguments&&... arguments)
+		requires(!std::is_same_v<std::decay_t<Argument>, Button::Name> && !std::is_same_v<std::decay_t<Argument>, Axis::Name>)
+		void combinationSelector(const std::size_t szCombination, Argument&& argument, Arguments&&... arguments)
 		{
-			this->combinationCreate(pCombination, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
+			this->combinationCreate(szCombination, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
 		}
 
-		template <typename FPress = std::function<void()>, typename FRelease = std::function<void()>>
-		void combinationCreate(const std::shared_ptr<Combination>& pCombination, FPress fPress = [] {}, FRelease fRelease = [] {})
+		template <typename FPress = void(*)(), typename FRelease = void(*)()>
+		void combinationCreate(const std::size_t szCombination, FPress fPress = [] {}, FRelease fRelease = [] {})
 		{
-			pCombination->fPress = fPress;
-			pCombination->fRelease = fRelease;
+			this->vCombinations[szCombination].action = this->makeAction(fPress, fRelease);
 		}
 
-		void combinationCreate(const std::shared_ptr<Combination>& pCombination, const mouse::Button::Name mouseButton)
+		void combinationCreate(const std::size_t szCombination, const mouse::Button::Name mouseButton)
 		{
-			this->combinationCreate(pCombination, [mouseButton]() { mouse::press(mouseButton); }, [mouseButton]() { mouse::release(mouseButton); });
+			this->vCombinations[szCombination].action = this->makeAction(mouseButton);
 		}
 
-		void combinationCreate(const std::shared_ptr<Combination>& pCombination, const mouse::Scroll::Name mouseScroll)
+		void combinationCreate(const std::size_t szCombination, const mouse::Scroll::Name mouseScroll)
 		{
-			this->combinationCreate(pCombination, [mouseScroll]() { mouse::scrollStep(mouseScroll); }, [] {});
+			this->vCombinations[szCombination].action = this->makeAction(mouseScroll);
 		}
 
-		void combinationCreate(const std::shared_ptr<Combination>& pCombination, const key::Key::Name key)
+		void combinationCreate(const std::size_t szCombination, const key::Key::Name key)
 		{
-			this->combinationCreate(pCombination, [key]() { key::press(key); }, [key]() { key::release(key); });
+			this->vCombinations[szCombination].action = this->makeAction(key);
 		}
 
-		void combinationCreate(const std::shared_ptr<Combination>& pCombination, const Event::Name event)
+		void combinationCreate(const std::size_t szCombination, const Event::Name event)
 		{
-			if (event < Event::Count)
-			{
-				switch (event)
-				{
-				case Event::Enable:
-				{
-					return this->combinationCreate(pCombination, [this]() { this->enable(); }, [] {});
-				}
-				case Event::Disable:
-				{
-					return this->combinationCreate(pCombination, [this]() { this->disable(); }, [] {});
-				}
-				case Event::Toggle:
-				{
-					return this->combinationCreate(pCombination, [this]() { this->toggle(); }, [] {});
-				}
-				default:
-				{
-					break;
-				}
-				}
-			}
+			this->vCombinations[szCombination].action = this->makeAction(event);
 		}
 
 	public:
 		template <const bool alwaysEnabled = false, typename... Arguments>
 		void combination(Arguments&&... arguments)
 		{
-			this->combinationSelector<alwaysEnabled>(std::make_shared<Combination>(), std::forward<Arguments>(arguments)...);
+			this->vCombinations.push_back(Combination());
+
+			this->combinationSelector<alwaysEnabled>(this->vCombinations.size() - 1, std::forward<Arguments>(arguments)...);
 		}
 
+		int index() const;
+
 		bool isConnected() const;
 
 		bool isEnabled() const;
@@ -506,11 +609,19 @@ namespace gp
 		void toggle();
 
 		bool isReady() const;
+
+		bool isActive() const;
+
+		// Sample to injection time of every output event of this pad.
+		const stats::Histogram& latency() const;
+
+		// Time between two successful reads of this pad.
+		const stats::Histogram& interval() const;
 	};
 
 	typedef std::shared_ptr<Gamepad> GamepadPtr;
 
-	extern GamepadPtr make(const int iIndex = 0, const bool bEnabled = true);
+	extern GamepadPtr make(const int iIndex = 0, const bool bEnabled = true, const BackendPtr& pBackend = defaultBackend());
 
-	extern GamepadPtr makeDefault(const int iIndex = 0, const bool bEnabled = true);
+	extern GamepadPtr makeDefault(const int iIndex = 0, const bool bEnabled = true, const BackendPtr& pBackend = defaultBackend());
 }
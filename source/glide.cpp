@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "glide.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace output
+{
+	namespace
+	{
+		// Position at s seconds after a sample for one component, the speed ramps from dFrom to dTo over dRamp and stops after dStale.
+		double position(const double dFrom, const double dTo, const double dRamp, const double dStale, double s)
+		{
+			s = std::min(s, dStale);
+
+			if (s <= dRamp)
+			{
+				return dFrom * s + (dTo - dFrom) * s * s / (2.0 * dRamp);
+			}
+
+			return (dFrom + dTo) * dRamp / 2.0 + dTo * (s - dRamp);
+		}
+
+		int whole(double& dRemainder, const double dValue)
+		{
+			dRemainder += dValue;
+
+			const int iValue = static_cast<int>(dRemainder);
+
+			dRemainder -= static_cast<double>(iValue);
+
+			return iValue;
+		}
+	}
+
+	Velocity Glide::distance(const std::chrono::steady_clock::duration begin, const std::chrono::steady_clock::duration end) const
+	{
+		const double dRamp = std::chrono::duration<double>(this->ramp).count();
+		const double dStale = std::chrono::duration<double>(Stale).count();
+		const double dBegin = std::chrono::duration<double>(begin).count();
+		const double dEnd = std::chrono::duration<double>(end).count();
+
+		const auto fDistance = [&](const double dFrom, const double dTo) {
+			return position(dFrom, dTo, dRamp, dStale, dEnd) - position(dFrom, dTo, dRamp, dStale, dBegin);
+		};
+
+		return {
+			fDistance(this->from.dMoveX, this->to.dMoveX),
+			fDistance(this->from.dMoveY, this->to.dMoveY),
+			fDistance(this->from.dScrollX, this->to.dScrollX),
+			fDistance(this->from.dScrollY, this->to.dScrollY)
+		};
+	}
+
+	void Glide::advance(const std::chrono::steady_clock::time_point tNow)
+	{
+		if (this->bSampled && tNow > this->tFrame)
+		{
+			const Velocity distance = this->distance(this->tFrame - this->tSample, tNow - this->tSample);
+
+			this->pending.dMoveX += distance.dMoveX;
+			this->pending.dMoveY += distance.dMoveY;
+			this->pending.dScrollX += distance.dScrollX;
+			this->pending.dScrollY += distance.dScrollY;
+		}
+
+		this->tFrame = std::max(this->tFrame, tNow);
+	}
+
+	void Glide::sample(const Velocity& velocity, const std::chrono::steady_clock::time_point tNow)
+	{
+		Velocity current;
+
+		if (this->bSampled)
+		{
+			this->advance(tNow);
+
+			// The new ramp starts from the speed the frames reached, whether the old ramp finished or not.
+			const std::chrono::steady_clock::duration since = tNow - this->tSample;
+
+			if (since < this->ramp)
+			{
+				const double dShare = std::chrono::duration<double>(since) / std::chrono::duration<double>(this->ramp);
+
+				current.dMoveX = this->from.dMoveX + (this->to.dMoveX - this->from.dMoveX) * dShare;
+				current.dMoveY = this->from.dMoveY + (this->to.dMoveY - this->from.dMoveY) * dShare;
+				current.dScrollX = this->from.dScrollX + (this->to.dScrollX - this->from.dScrollX) * dShare;
+				current.dScrollY = this->from.dScrollY + (this->to.dScrollY - this->from.dScrollY) * dShare;
+			}
+			else if (since <= Stale)
+			{
+				current = this->to;
+			}
+
+			this->ramp = std::clamp<std::chrono::steady_clock::duration>(since, std::chrono::milliseconds(1), Stale);
+		}
+		else
+		{
+			this->tFrame = tNow;
+		}
+
+		this->from = current;
+		this->to = velocity;
+
+		this->tSample = tNow;
+
+		this->bSampled = true;
+	}
+
+	std::size_t Glide::frame(const std::chrono::steady_clock::time_point tNow, Event* pEvents)
+	{
+		this->advance(tNow);
+
+		std::size_t szCount = 0;
+
+		const int iMoveX = whole(this->remainder.dMoveX, this->pending.dMoveX);
+		const int iMoveY = whole(this->remainder.dMoveY, this->pending.dMoveY);
+		const int iScrollX = whole(this->remainder.dScrollX, this->pending.dScrollX);
+		const int iScrollY = whole(this->remainder.dScrollY, this->pending.dScrollY);
+
+		this->pending = Velocity();
+
+		if (iMoveX != 0 || iMoveY != 0)
+		{
+			pEvents[szCount++] = { Event::Move, 0, iMoveX, iMoveY };
+		}
+
+		if (iScrollX != 0 || iScrollY != 0)
+		{
+			pEvents[szCount++] = { Event::Scroll, 0, iScrollX, iScrollY };
+		}
+
+		return szCount;
+	}
+
+	void Glide::reset()
+	{
+		*this = Glide();
+	}
+}
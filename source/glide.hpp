@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "output.hpp"
+
+namespace output
+{
+	// Turns velocity samples that arrive at the poll rate into motion for frames at any other rate.
+	// A new sample is approached linearly over the interval that preceded it, so the speed never steps,
+	// and the last speed is held for frames after the ramp until the samples stop for longer than the stale time.
+	class Glide
+	{
+	private:
+		Velocity from;
+		Velocity to;
+
+		std::chrono::steady_clock::time_point tSample;
+		std::chrono::steady_clock::time_point tFrame;
+
+		std::chrono::steady_clock::duration ramp = std::chrono::milliseconds(1);
+
+		bool bSampled = false;
+
+		// Motion between the last frame and a sample that ended the previous ramp, plus the sub-unit remainders.
+		Velocity pending;
+		Velocity remainder;
+
+		Velocity distance(const std::chrono::steady_clock::duration begin, const std::chrono::steady_clock::duration end) const;
+
+		void advance(const std::chrono::steady_clock::time_point tNow);
+
+	public:
+		static constexpr std::chrono::milliseconds Stale = std::chrono::milliseconds(100);
+
+		void sample(const Velocity& velocity, const std::chrono::steady_clock::time_point tNow);
+
+		// Writes up to two events, one move and one scroll, with the whole units travelled since the previous frame.
+		std::size_t frame(const std::chrono::steady_clock::time_point tNow, Event* pEvents);
+
+		void reset();
+	};
+}
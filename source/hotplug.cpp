@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hotplug.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace gp
+{
+	int Hotplug::descriptor() const
+	{
+		return -1;
+	}
+
+	void FakeHotplug::add(const std::string& sName)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->notifications.push_back({ Notification::Added, sName, std::chrono::steady_clock::now() });
+	}
+
+	void FakeHotplug::remove(const std::string& sName)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->notifications.push_back({ Notification::Removed, sName, std::chrono::steady_clock::now() });
+	}
+
+	bool FakeHotplug::next(Notification& notification)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (this->notifications.empty())
+		{
+			return false;
+		}
+
+		notification = this->notifications.front();
+
+		this->notifications.pop_front();
+
+		return true;
+	}
+
+	FakeHotplugPtr makeFakeHotplug()
+	{
+		return std::make_shared<FakeHotplug>();
+	}
+
+#ifdef __linux__
+	class InotifyHotplug : public Hotplug
+	{
+	private:
+		int iDescriptor = -1;
+
+		std::deque<Notification> notifications;
+
+	public:
+		InotifyHotplug(const std::string& sDirectory) :
+			iDescriptor(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+		{
+			// Device nodes are created before udev grants access to them, so attribute changes count as well.
+			if (this->iDescriptor >= 0 && inotify_add_watch(this->iDescriptor, sDirectory.c_str(), IN_CREATE | IN_ATTRIB | IN_DELETE) < 0)
+			{
+				close(this->iDescriptor);
+
+				this->iDescriptor = -1;
+			}
+		}
+
+		~InotifyHotplug()
+		{
+			if (this->iDescriptor >= 0)
+			{
+				close(this->iDescriptor);
+			}
+		}
+
+		bool isValid() const
+		{
+			return this->iDescriptor >= 0;
+		}
+
+		int descriptor() const override
+		{
+			return this->iDescriptor;
+		}
+
+		bool next(Notification& notification) override
+		{
+			while (this->notifications.empty())
+			{
+				alignas(inotify_event) char cBuffer[4096];
+
+				const ssize_t sRead = read(this->iDescriptor, cBuffer, sizeof(cBuffer));
+
+				if (sRead <= 0)
+				{
+					if (sRead < 0 && errno == EINTR)
+					{
+						continue;
+					}
+
+					return false;
+				}
+
+				const std::chrono::steady_clock::time_point tSeen = std::chrono::steady_clock::now();
+
+				for (ssize_t sOffset = 0; sOffset < sRead;)
+				{
+					const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(cBuffer + sOffset);
+
+					sOffset += static_cast<ssize_t>(sizeof(inotify_event) + pEvent->len);
+
+					if (pEvent->len == 0)
+					{
+						continue;
+					}
+
+					const Notification::Type type = (pEvent->mask & IN_DELETE) ? Notification::Removed : (pEvent->mask & IN_CREATE) ? Notification::Added : Notification::Changed;
+
+					this->notifications.push_back({ type, pEvent->name, tSeen });
+				}
+			}
+
+			notification = this->notifications.front();
+
+			this->notifications.pop_front();
+
+			return true;
+		}
+	};
+
+	HotplugPtr makeInotifyHotplug(const std::string& sDirectory)
+	{
+		std::shared_ptr<InotifyHotplug> pHotplug = std::make_shared<InotifyHotplug>(sDirectory);
+
+		return pHotplug->isValid() ? pHotplug : nullptr;
+	}
+#else
+	HotplugPtr makeInotifyHotplug(const std::string&)
+	{
+		return nullptr;
+	}
+#endif
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gp
+{
+	// Tells a backend when device nodes appear or vanish, so it never has to probe empty slots.
+	class Hotplug
+	{
+	public:
+		struct Notification
+		{
+			typedef enum : int
+			{
+				Added,
+				Changed,
+				Removed,
+				Count
+			} Type;
+
+			Type type = Added;
+
+			std::string sName;
+
+			std::chrono::steady_clock::time_point tSeen;
+		};
+
+		virtual ~Hotplug() = default;
+
+		// Becomes readable when notifications are pending, -1 if the source has to be polled.
+		virtual int descriptor() const;
+
+		virtual bool next(Notification& notification) = 0;
+	};
+
+	typedef std::shared_ptr<Hotplug> HotplugPtr;
+
+	// Notifications are injected by hand, for tests and benchmarks.
+	class FakeHotplug : public Hotplug
+	{
+	private:
+		std::mutex mutex;
+
+		std::deque<Notification> notifications;
+
+	public:
+		void add(const std::string& sName);
+
+		void remove(const std::string& sName);
+
+		bool next(Notification& notification) override;
+	};
+
+	typedef std::shared_ptr<FakeHotplug> FakeHotplugPtr;
+
+	extern HotplugPtr makeInotifyHotplug(const std::string& sDirectory);
+
+	extern FakeHotplugPtr makeFakeHotplug();
+}
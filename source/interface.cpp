@@ -25,49 +25,905 @@
 #include "interface.h"
 
 #include "gamepad.hpp"
+#include "pads.hpp"
+#include "scheduler.hpp"
+#include "output.hpp"
+#include "trace.hpp"
+#include "queue.hpp"
+#include "readers.hpp"
+#include "prober.hpp"
+#include "profile.hpp"
+#include "switcher.hpp"
 
-gp::GamepadPtr gamepads[4] = { };
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+gp::BackendPtr pBackend = nullptr;
+
+gp::ReadersPtr pReaders = nullptr;
+
+int iReadersInterval = 0;
+
+gp::ProberPtr pProber = nullptr;
+
+bool bStagger = true;
+
+int iOutputRate = 0;
+
+std::string sProfilePath;
+
+gp::profile::WatcherPtr pWatcher = nullptr;
+
+std::vector<gp::profile::Switcher::Rule> vRules;
+
+gp::profile::SwitcherPtr pSwitcher = nullptr;
+
+// Built-in layout the pads go back to when the focused application has no profile and there is no default one.
+gp::GamepadPtr pBuiltIn = nullptr;
+
+// Profile the pads are bound to, only the poll thread reads it and asks the watcher for a newer one.
+const gp::profile::Profile* pProfile = nullptr;
+
+// Time to copy a new profile into every pad, taken on the poll thread.
+stats::Histogram swapHistogram;
+
+gp::Pads gamepads;
+
+gp::Scheduler scheduler;
+
+struct Command
+{
+	typedef enum : int
+	{
+		Toggle,
+		Enable,
+		Disable,
+		QuietPeriod,
+		Count
+	} Type;
+
+	Type type = Toggle;
+
+	gp::Pads::Id id = gp::Pads::Invalid;
+
+	int iMilliseconds = 0;
+};
+
+// Written by the UI thread and drained by the poll thread at the start of every tick.
+gp::Queue<Command, 64> commands;
+
+// Copy of the registry for the UI thread, the poll thread only rebuilds it when a pad changes.
+struct Snapshot
+{
+	struct Entry
+	{
+		gp::GamepadPtr gamepad;
+
+		gp::Pads::Id id = gp::Pads::Invalid;
+
+		bool bConnected = false;
+		bool bEnabled = false;
+	};
+
+	std::vector<Entry> vEntries;
+
+	// Position of every registry slot, ids keep their slot in the low 16 bits.
+	std::vector<std::size_t> vPositions;
+
+	const Entry* find(const int iId) const
+	{
+		const std::size_t szSlot = static_cast<gp::Pads::Id>(iId) & 0xFFFF;
+
+		if (szSlot >= this->vPositions.size() || this->vPositions[szSlot] >= this->vEntries.size())
+		{
+			return nullptr;
+		}
+
+		const Entry& entry = this->vEntries[this->vPositions[szSlot]];
+
+		return entry.id == static_cast<gp::Pads::Id>(iId) ? &entry : nullptr;
+	}
+};
+
+// The poll thread rebuilds the buffer readers are not pointed at and then swaps the index, reusing both buffers' capacity.
+Snapshot snapshots[2];
+
+std::atomic<int> iSnapshot = 0;
+
+// UI threads inside either buffer, the poll thread only rewrites one while this is 0 and otherwise retries on the next tick.
+std::atomic<int> iSnapshotReaders = 0;
+
+bool bSnapshotDirty = true;
+
+// Keeps the buffer that was current on entry, and the pads it points to, intact until the reader leaves.
+struct SnapshotReader
+{
+	const Snapshot* pSnapshot = nullptr;
+
+	SnapshotReader()
+	{
+		iSnapshotReaders.fetch_add(1);
+
+		this->pSnapshot = &snapshots[iSnapshot.load()];
+	}
+
+	~SnapshotReader()
+	{
+		iSnapshotReaders.fetch_sub(1, std::memory_order_release);
+	}
+
+	const Snapshot* operator->() const
+	{
+		return this->pSnapshot;
+	}
+};
+
+void publish()
+{
+	if (!bSnapshotDirty || iSnapshotReaders.load() != 0)
+	{
+		return;
+	}
+
+	const int iNext = 1 - iSnapshot.load(std::memory_order_relaxed);
+
+	Snapshot& next = snapshots[iNext];
+
+	next.vEntries.resize(gamepads.size());
+
+	std::fill(next.vPositions.begin(), next.vPositions.end(), SIZE_MAX);
+
+	for (std::size_t i = 0; i < gamepads.size(); i++)
+	{
+		const gp::Pads::Id id = gamepads.id(i);
+
+		next.vEntries[i] = { gamepads[i], id, gamepads[i]->isConnected(), gamepads[i]->isEnabled() };
+
+		if ((id & 0xFFFF) >= next.vPositions.size())
+		{
+			next.vPositions.resize((id & 0xFFFF) + 1, SIZE_MAX);
+		}
+
+		next.vPositions[id & 0xFFFF] = i;
+	}
+
+	iSnapshot.store(iNext);
+
+	bSnapshotDirty = false;
+}
+
+std::atomic<int> iPollRate = 0;
+
+// Seconds spent at each rate, copied from the scheduler after every tick for the UI thread.
+std::vector<std::atomic<double>> vPollRateTimes(scheduler.rates().size());
+
+// Time spent in gamepadsUpdate(), the worst tick shows whether probing empty slots stalls the connected pads.
+stats::Histogram tickHistogram;
+
+// Hotplug backends only get pads for present devices, every empty slot would otherwise be probed every 250 ms.
+stats::Histogram attachLatency;
+
+std::chrono::steady_clock::time_point tHotplug = std::chrono::steady_clock::now();
+double dAbsentSeconds = 0.0;
+std::atomic<unsigned long long> ullProbesAvoided = 0;
+
+// Taken while the statics are initialized, before main() or WinMain() runs.
+const std::chrono::steady_clock::time_point tLaunch = std::chrono::steady_clock::now();
+
+std::atomic<double> dStartupMilliseconds = 0.0;
+
+// gamepadsWait() only counts, the rate is taken over the last one to two seconds whenever it is read, so it also falls while the loop sleeps.
+std::atomic<unsigned long long> ullWakeups = 0;
+
+struct Wakeups
+{
+	std::atomic<std::chrono::steady_clock::rep> llTime = tLaunch.time_since_epoch().count();
+
+	std::atomic<unsigned long long> ullCount = 0;
+};
+
+Wakeups wakeupsWindows[2];
 
 int gamepadsCount()
 {
-	return static_cast<int>(sizeof(gamepads) / sizeof(gp::GamepadPtr));
+	const SnapshotReader snapshot;
+
+	return static_cast<int>(snapshot->vEntries.size());
+}
+
+int gamepadsIdAt(const int iPosition)
+{
+	const SnapshotReader snapshot;
+
+	if (iPosition < 0 || static_cast<std::size_t>(iPosition) >= snapshot->vEntries.size())
+	{
+		return -1;
+	}
+
+	return static_cast<int>(snapshot->vEntries[iPosition].id);
+}
+
+int gamepadAttach(const int iIndex)
+{
+	bSnapshotDirty = true;
+
+	if (pProfile)
+	{
+		gp::GamepadPtr gamepad = gp::make(iIndex, false, pBackend);
+
+		gamepad->adopt(pProfile->bindings());
+
+		return static_cast<int>(gamepads.add(gamepad));
+	}
+
+	return static_cast<int>(gamepads.add(gp::makeDefault(iIndex, false, pBackend)));
+}
+
+int gamepadDetach(const int iId)
+{
+	bSnapshotDirty = true;
+
+	return static_cast<int>(gamepads.remove(static_cast<gp::Pads::Id>(iId)));
+}
+
+void gamepadsRecord(const char* szPath)
+{
+	std::string sPath = szPath;
+
+	sPath.erase(0, sPath.find_first_not_of(" \""));
+	sPath.erase(sPath.find_last_not_of(" \"") + 1);
+
+	if (!sPath.empty())
+	{
+		pBackend = gp::trace::makeRecorder(gp::defaultBackend(), sPath);
+	}
+}
+
+void gamepadsPlayback(const char* szPath, const int iCount)
+{
+	pBackend = gp::makeFileBackend(szPath, iCount);
+}
+
+void hotplug()
+{
+	if (!pBackend || !pBackend->isHotplug())
+	{
+		return;
+	}
+
+	gp::Change changes[16];
+
+	while (const std::size_t szChanges = pBackend->changes(changes, std::size(changes)))
+	{
+		for (std::size_t i = 0; i < szChanges; i++)
+		{
+			const gp::Change& change = changes[i];
+
+			std::size_t szPosition = 0;
+
+			while (szPosition < gamepads.size() && gamepads[szPosition]->index() != change.iIndex)
+			{
+				szPosition++;
+			}
+
+			if (change.type == gp::Change::Attached && szPosition == gamepads.size())
+			{
+				gamepadAttach(change.iIndex);
+
+				attachLatency.record(std::chrono::steady_clock::now() - change.tSeen);
+			}
+			else if (change.type == gp::Change::Detached && szPosition < gamepads.size())
+			{
+				// One last update sees the empty slot and releases whatever the pad still holds.
+				gamepads[szPosition]->update();
+
+				gamepadDetach(static_cast<int>(gamepads.id(szPosition)));
+			}
+		}
+	}
+
+	const std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+	dAbsentSeconds += static_cast<double>(std::max(pBackend->count() - static_cast<int>(gamepads.size()), 0)) * std::chrono::duration<double>(tNow - tHotplug).count();
+
+	tHotplug = tNow;
+
+	ullProbesAvoided.store(static_cast<unsigned long long>(dAbsentSeconds / 0.25), std::memory_order_relaxed);
+}
+
+void gamepadsReaders(const int iInterval)
+{
+	iReadersInterval = iInterval;
+}
+
+void gamepadsStagger(const int bEnable)
+{
+	bStagger = bEnable;
+}
+
+void gamepadsFixedPoint(const int bEnable)
+{
+	gamepads.fixed(bEnable);
+}
+
+void gamepadsOutputRate(const int iRate)
+{
+	iOutputRate = iRate;
+}
+
+void gamepadsProfile(const char* szPath)
+{
+	sProfilePath = szPath ? szPath : "";
+}
+
+void gamepadsApplicationProfile(const char* szApplication, const char* szPath)
+{
+	if (szApplication && szPath)
+	{
+		vRules.push_back({ szApplication, szPath });
+	}
+}
+
+void gamepadsApplicationProfiles(const char* szPath)
+{
+	if (szPath)
+	{
+		const std::vector<gp::profile::Switcher::Rule> vLoaded = gp::profile::loadRules(szPath);
+
+		vRules.insert(vRules.end(), vLoaded.begin(), vLoaded.end());
+	}
 }
 
 void gamepadsInitialize()
 {
-	for (int iIndex = 0; iIndex < gamepadsCount(); iIndex++)
+	if (!sProfilePath.empty())
 	{
-		gamepads[iIndex] = gp::makeDefault(iIndex, false);
+		pWatcher = gp::profile::makeWatcher(sProfilePath);
+
+		pProfile = pWatcher->acquire();
+	}
+
+	if (!vRules.empty())
+	{
+		pSwitcher = gp::profile::makeSwitcher(gp::makeFocus(), pWatcher, vRules);
+
+		if (pSwitcher)
+		{
+			pBuiltIn = gp::makeDefault(0, true, nullptr);
+
+			pProfile = pSwitcher->acquire();
+		}
 	}
+
+	if (!pBackend)
+	{
+		pBackend = gp::defaultBackend();
+	}
+
+	if (iReadersInterval > 0)
+	{
+		pReaders = gp::makeReaders(pBackend, std::chrono::microseconds(iReadersInterval));
+
+		if (pReaders)
+		{
+			pBackend = pReaders;
+		}
+	}
+
+	if (bStagger && !pReaders && pBackend && !pBackend->isHotplug())
+	{
+		pProber = gp::makeProber(pBackend);
+
+		if (pProber)
+		{
+			pBackend = pProber;
+		}
+	}
+
+	if (pBackend && pBackend->isHotplug())
+	{
+		tHotplug = std::chrono::steady_clock::now();
+
+		hotplug();
+	}
+	else
+	{
+		for (int iIndex = 0; pBackend && iIndex < pBackend->count(); iIndex++)
+		{
+			gamepadAttach(iIndex);
+		}
+	}
+
+	output::glide(iOutputRate);
+
+	iPollRate = scheduler.rate();
+
+	publish();
 }
 
 void gamepadsTerminate()
 {
-	for (int iIndex = 0; iIndex < gamepadsCount(); iIndex++)
+	output::glide(0);
+
+	gamepads.clear();
+
+	pProfile = nullptr;
+	pSwitcher = nullptr;
+	pWatcher = nullptr;
+	pBuiltIn = nullptr;
+
+	// Without readers both buffers let go of the pads, otherwise the next initialization replaces them.
+	bSnapshotDirty = true;
+
+	publish();
+
+	bSnapshotDirty = true;
+
+	publish();
+
+	pProber = nullptr;
+	pReaders = nullptr;
+	pBackend = nullptr;
+}
+
+void gamepadsUpdate()
+{
+	const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+	if (pSwitcher || pWatcher)
+	{
+		const gp::profile::Profile* pLatest = pSwitcher ? pSwitcher->acquire() : pWatcher->acquire();
+
+		// Without a switcher the built-in layout is only ever replaced, a profile that stops compiling keeps its last version.
+		if (pLatest != pProfile && (pLatest || pBuiltIn))
+		{
+			pProfile = pLatest;
+
+			const gp::Gamepad& layout = pProfile ? pProfile->bindings() : *pBuiltIn;
+
+			for (std::size_t i = 0; i < gamepads.size(); i++)
+			{
+				gamepads[i]->adopt(layout);
+			}
+
+			swapHistogram.record(std::chrono::steady_clock::now() - tStart);
+		}
+	}
+
+	hotplug();
+
+	Command command;
+
+	while (commands.pop(command))
+	{
+		if (command.type == Command::QuietPeriod)
+		{
+			scheduler.setQuietPeriod(std::chrono::milliseconds(command.iMilliseconds));
+
+			continue;
+		}
+
+		const std::size_t szPosition = gamepads.find(command.id);
+
+		if (szPosition == gamepads.size())
+		{
+			continue;
+		}
+
+		switch (command.type)
+		{
+		case Command::Toggle:
+		{
+			gamepads[szPosition]->toggle();
+
+			break;
+		}
+		case Command::Enable:
+		{
+			gamepads[szPosition]->enable();
+
+			break;
+		}
+		case Command::Disable:
+		{
+			gamepads[szPosition]->disable();
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
+		}
+	}
+
+	if (pReaders)
+	{
+		pReaders->dispatch([](const int iIndex) {
+			for (std::size_t i = 0; i < gamepads.size(); i++)
+			{
+				if (gamepads[i]->index() == iIndex)
+				{
+					gamepads[i]->update();
+				}
+			}
+		});
+	}
+
+	bool bActive = false;
+
+	gamepads.update();
+
+	// Only this thread rewrites the buffers, so it reads the current one without registering.
+	const Snapshot& current = snapshots[iSnapshot.load(std::memory_order_relaxed)];
+
+	for (std::size_t i = 0; i < gamepads.size(); i++)
+	{
+		bActive |= gamepads[i]->isActive();
+
+		if (!bSnapshotDirty)
+		{
+			const Snapshot::Entry& entry = current.vEntries[i];
+
+			bSnapshotDirty = entry.bConnected != gamepads[i]->isConnected() || entry.bEnabled != gamepads[i]->isEnabled();
+		}
+	}
+
+	output::commit();
+
+	scheduler.update(bActive);
+
+	iPollRate.store(scheduler.rate(), std::memory_order_relaxed);
+
+	for (std::size_t i = 0; i < vPollRateTimes.size(); i++)
+	{
+		vPollRateTimes[i].store(scheduler.time(i), std::memory_order_relaxed);
+	}
+
+	publish();
+
+	const std::chrono::steady_clock::time_point tEnd = std::chrono::steady_clock::now();
+
+	if (tickHistogram.count() == 0)
+	{
+		dStartupMilliseconds.store(std::chrono::duration<double, std::milli>(tEnd - tLaunch).count(), std::memory_order_relaxed);
+	}
+
+	tickHistogram.record(tEnd - tStart);
+}
+
+int gamepadsWait()
+{
+	if (!pBackend)
+	{
+		return 0;
+	}
+
+	int iWait = scheduler.interval();
+
+	if (pBackend->isEventDriven())
 	{
-		gamepads[iIndex] = nullptr;
+		bool bActive = false;
+		bool bDisconnected = false;
+
+		for (std::size_t i = 0; i < gamepads.size(); i++)
+		{
+			bActive |= gamepads[i]->isActive();
+			bDisconnected |= !gamepads[i]->isConnected();
+		}
+
+		if (!bActive)
+		{
+			iWait = bDisconnected ? 250 : -1;
+		}
 	}
+
+	const bool bReady = pBackend->wait(iWait);
+
+	ullWakeups.fetch_add(1, std::memory_order_relaxed);
+
+	return static_cast<int>(bReady);
 }
 
-void gamepadsUpdate()
+void gamepadsWake()
 {
-	for (int iIndex = 0; iIndex < gamepadsCount(); iIndex++)
+	if (pBackend)
 	{
-		gamepads[iIndex]->update();
+		pBackend->wake();
 	}
 }
 
-int gamepadIsConnected(const int iIndex)
+double gamepadsWakeupsPerSecond()
 {
-	return static_cast<int>(gamepads[iIndex]->isConnected());
+	const std::chrono::steady_clock::rep llNow = std::chrono::steady_clock::now().time_since_epoch().count();
+	const unsigned long long ullNow = ullWakeups.load(std::memory_order_relaxed);
+
+	// The rate runs from the start of the previous window, a new window starts once the current one is a second old.
+	if (std::chrono::steady_clock::duration(llNow - wakeupsWindows[1].llTime.load()) >= std::chrono::seconds(1))
+	{
+		wakeupsWindows[0].llTime.store(wakeupsWindows[1].llTime.load());
+		wakeupsWindows[0].ullCount.store(wakeupsWindows[1].ullCount.load());
+
+		wakeupsWindows[1].llTime.store(llNow);
+		wakeupsWindows[1].ullCount.store(ullNow);
+	}
+
+	const double dElapsed = std::chrono::duration<double>(std::chrono::steady_clock::duration(llNow - wakeupsWindows[0].llTime.load())).count();
+
+	return dElapsed > 0.0 ? static_cast<double>(ullNow - wakeupsWindows[0].ullCount.load()) / dElapsed : 0.0;
 }
 
-int gamepadIsEnabled(const int iIndex)
+int gamepadsPollRate()
 {
-	return static_cast<int>(gamepads[iIndex]->isEnabled());
+	return iPollRate.load(std::memory_order_relaxed);
 }
 
-void gamepadToggle(const int iIndex)
+int gamepadsPollRatesCount()
 {
-	gamepads[iIndex]->toggle();
+	return static_cast<int>(scheduler.rates().size());
+}
+
+int gamepadsPollRateAt(const int iIndex)
+{
+	return iIndex >= 0 && static_cast<std::size_t>(iIndex) < scheduler.rates().size() ? scheduler.rates()[iIndex] : 0;
+}
+
+double gamepadsPollRateTime(const int iIndex)
+{
+	return iIndex >= 0 && static_cast<std::size_t>(iIndex) < vPollRateTimes.size() ? vPollRateTimes[iIndex].load(std::memory_order_relaxed) : 0.0;
+}
+
+void gamepadsPollQuietPeriod(const int iMilliseconds)
+{
+	if (commands.push({ Command::QuietPeriod, gp::Pads::Invalid, iMilliseconds }))
+	{
+		gamepadsWake();
+	}
+}
+
+unsigned long long gamepadsOutputQueued()
+{
+	return output::statistics().ullQueued;
+}
+
+unsigned long long gamepadsOutputCoalesced()
+{
+	return output::statistics().ullCoalesced;
+}
+
+unsigned long long gamepadsOutputSyscalls()
+{
+	return output::statistics().ullSyscalls;
+}
+
+unsigned long long gamepadsOutputFrames()
+{
+	return output::statistics().ullFrames;
+}
+
+unsigned long long gamepadsProfileLoads()
+{
+	return pWatcher ? pWatcher->statistics().ullLoads : 0;
+}
+
+unsigned long long gamepadsProfileErrors()
+{
+	return pWatcher ? pWatcher->statistics().ullErrors : 0;
+}
+
+unsigned long long gamepadsProfileCached()
+{
+	return pWatcher ? pWatcher->statistics().ullCached : 0;
+}
+
+unsigned long long gamepadsProfileSwitches()
+{
+	return pSwitcher ? pSwitcher->statistics().ullSwitches : 0;
+}
+
+unsigned long long gamepadsProbesAvoided()
+{
+	return ullProbesAvoided.load(std::memory_order_relaxed);
+}
+
+double gamepadsStartupTime()
+{
+	return dStartupMilliseconds.load(std::memory_order_relaxed);
+}
+
+double gamepadsTickMax()
+{
+	return std::chrono::duration<double, std::milli>(tickHistogram.max()).count();
+}
+
+unsigned long long gamepadsProbes()
+{
+	return pProber ? pProber->statistics().ullProbes : 0;
+}
+
+unsigned long long gamepadsProbesDeferred()
+{
+	return pProber ? pProber->statistics().ullDeferred : 0;
+}
+
+unsigned long long gamepadsReaderDeltas()
+{
+	return pReaders ? pReaders->statistics().ullDeltas : 0;
+}
+
+unsigned long long gamepadsReaderDrops()
+{
+	return pReaders ? pReaders->statistics().ullDrops : 0;
+}
+
+int gamepadsReaderDepth()
+{
+	return pReaders ? static_cast<int>(pReaders->statistics().szDepth) : 0;
+}
+
+int gamepadsReaderDepthMax()
+{
+	return pReaders ? static_cast<int>(pReaders->statistics().szDepthMax) : 0;
+}
+
+int gamepadsStatistics(char* szBuffer, const int iSize)
+{
+	if (iSize <= 0)
+	{
+		return 0;
+	}
+
+	int iLength = 0;
+
+	const auto fPrint = [&](const char* szName, const stats::Histogram& histogram) {
+		if (iLength < 0 || iLength >= iSize)
+		{
+			return;
+		}
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "  %-8s p50 %8.3f  p99 %8.3f  p99.9 %8.3f  max %8.3f ms  (%llu)\n", szName,
+			std::chrono::duration<double, std::milli>(histogram.percentile(50.0)).count(),
+			std::chrono::duration<double, std::milli>(histogram.percentile(99.0)).count(),
+			std::chrono::duration<double, std::milli>(histogram.percentile(99.9)).count(),
+			std::chrono::duration<double, std::milli>(histogram.max()).count(),
+			static_cast<unsigned long long>(histogram.count()));
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+	};
+
+	const SnapshotReader snapshot;
+
+	for (std::size_t i = 0; i < snapshot->vEntries.size() && iLength >= 0 && iLength < iSize; i++)
+	{
+		const gp::GamepadPtr& gamepad = snapshot->vEntries[i].gamepad;
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Gamepad %d\n", gamepad->index());
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+
+		fPrint("latency", gamepad->latency());
+		fPrint("interval", gamepad->interval());
+	}
+
+	if (iLength >= 0 && iLength < iSize)
+	{
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Ticks\n  first after %.3f ms\n", dStartupMilliseconds.load(std::memory_order_relaxed));
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+
+		fPrint("update", tickHistogram);
+	}
+
+	if (output::isGliding() && iLength >= 0 && iLength < iSize)
+	{
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Output\n  rate %d Hz  frames %llu\n", iOutputRate, output::statistics().ullFrames);
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+	}
+
+	if (pWatcher && iLength >= 0 && iLength < iSize)
+	{
+		const gp::profile::Watcher::Statistics statistics = pWatcher->statistics();
+
+		const std::string sError = pWatcher->error();
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Profile\n  loads %llu  cached %llu  errors %llu%s%s\n", statistics.ullLoads, statistics.ullCached, statistics.ullErrors, sError.empty() ? "" : "  ", sError.c_str());
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+
+		fPrint("load", pWatcher->load());
+		fPrint("swap", swapHistogram);
+	}
+
+	if (pSwitcher && iLength >= 0 && iLength < iSize)
+	{
+		const gp::profile::Switcher::Statistics statistics = pSwitcher->statistics();
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Focus\n  switches %llu  lookups %llu\n", statistics.ullSwitches, statistics.ullLookups);
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+
+		if (!pWatcher)
+		{
+			fPrint("swap", swapHistogram);
+		}
+	}
+
+	if (pProber && iLength >= 0 && iLength < iSize)
+	{
+		const gp::Prober::Statistics statistics = pProber->statistics();
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Probes\n  probes %llu  deferred %llu\n", statistics.ullProbes, statistics.ullDeferred);
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+	}
+
+	if (pBackend && pBackend->isHotplug() && iLength >= 0 && iLength < iSize)
+	{
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Hotplug\n  probes avoided %llu\n", ullProbesAvoided.load(std::memory_order_relaxed));
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+
+		fPrint("attach", attachLatency);
+	}
+
+	if (pReaders && iLength >= 0 && iLength < iSize)
+	{
+		const gp::Readers::Statistics statistics = pReaders->statistics();
+
+		const int iPrinted = std::snprintf(szBuffer + iLength, static_cast<std::size_t>(iSize - iLength), "Readers\n  deltas %llu  drops %llu  depth %d  max depth %d\n", statistics.ullDeltas, statistics.ullDrops, static_cast<int>(statistics.szDepth), static_cast<int>(statistics.szDepthMax));
+
+		iLength = iPrinted < 0 ? iPrinted : iLength + iPrinted;
+	}
+
+	return iLength < 0 ? 0 : std::min(iLength, iSize - 1);
+}
+
+int gamepadIndex(const int iId)
+{
+	const SnapshotReader snapshot;
+
+	const Snapshot::Entry* pEntry = snapshot->find(iId);
+
+	return pEntry ? pEntry->gamepad->index() : -1;
+}
+
+int gamepadIsConnected(const int iId)
+{
+	const SnapshotReader snapshot;
+
+	const Snapshot::Entry* pEntry = snapshot->find(iId);
+
+	return pEntry && pEntry->bConnected;
+}
+
+int gamepadIsEnabled(const int iId)
+{
+	const SnapshotReader snapshot;
+
+	const Snapshot::Entry* pEntry = snapshot->find(iId);
+
+	return pEntry && pEntry->bEnabled;
+}
+
+void gamepadToggle(const int iId)
+{
+	if (commands.push({ Command::Toggle, static_cast<gp::Pads::Id>(iId) }))
+	{
+		gamepadsWake();
+	}
+}
+
+void gamepadEnable(const int iId, const int bEnable)
+{
+	if (commands.push({ bEnable ? Command::Enable : Command::Disable, static_cast<gp::Pads::Id>(iId) }))
+	{
+		gamepadsWake();
+	}
 }
@@ -30,16 +30,121 @@
 #define EXTERN
 #endif
 
+// Pads are addressed by ids that stay valid until the pad is detached, positions 0 to gamepadsCount() - 1 enumerate them.
 EXTERN int gamepadsCount();
 
+EXTERN int gamepadsIdAt(const int iPosition);
+
+// Attaching and detaching must happen on the thread that calls gamepadsUpdate(), or before it starts.
+EXTERN int gamepadAttach(const int iIndex);
+
+EXTERN int gamepadDetach(const int iId);
+
+EXTERN void gamepadsRecord(const char* szPath);
+
+// Reads iCount pads from a file of raw states, looping at its end, instead of the devices, must be called before gamepadsInitialize().
+EXTERN void gamepadsPlayback(const char* szPath, const int iCount);
+
+// Reads every attached pad on its own thread, blocking on the device where the backend allows and otherwise every
+// iInterval microseconds, must be called before gamepadsInitialize().
+EXTERN void gamepadsReaders(const int iInterval);
+
+// Spreads probes of empty slots over ticks with a per slot backoff, on by default and ignored with readers or hotplug, must be called before gamepadsInitialize().
+EXTERN void gamepadsStagger(const int bEnable);
+
+// Runs the sticks through the integer pipeline, must be called before gamepadsInitialize().
+EXTERN void gamepadsFixedPoint(const int bEnable);
+
+// Emits cursor and wheel motion from its own thread iRate times per second, interpolating the speed between updates,
+// 0 (the default) emits it on every update, must be called before gamepadsInitialize().
+EXTERN void gamepadsOutputRate(const int iRate);
+
+// Binds the pads from a profile file instead of the built-in layout and reloads it whenever the file changes,
+// compiled profiles are cached next to it in szPath.cache, must be called before gamepadsInitialize().
+EXTERN void gamepadsProfile(const char* szPath);
+
+// Binds the pads from the profile at szPath while szApplication (an executable name such as "firefox.exe") has the focus,
+// the default profile or the built-in layout applies everywhere else, must be called before gamepadsInitialize().
+EXTERN void gamepadsApplicationProfile(const char* szApplication, const char* szPath);
+
+// Adds the rules of a file with one "<application> <profile>" per line, such as "game.exe game.profile",
+// a missing file adds none, must be called before gamepadsInitialize().
+EXTERN void gamepadsApplicationProfiles(const char* szPath);
+
 EXTERN void gamepadsInitialize();
 
 EXTERN void gamepadsTerminate();
 
 EXTERN void gamepadsUpdate();
 
-EXTERN int gamepadIsConnected(const int iIndex);
+EXTERN int gamepadsWait();
+
+EXTERN void gamepadsWake();
+
+EXTERN double gamepadsWakeupsPerSecond();
+
+EXTERN int gamepadsPollRate();
+
+EXTERN int gamepadsPollRatesCount();
+
+EXTERN int gamepadsPollRateAt(const int iIndex);
+
+EXTERN double gamepadsPollRateTime(const int iIndex);
+
+EXTERN void gamepadsPollQuietPeriod(const int iMilliseconds);
+
+EXTERN unsigned long long gamepadsOutputQueued();
+
+EXTERN unsigned long long gamepadsOutputCoalesced();
+
+EXTERN unsigned long long gamepadsOutputSyscalls();
+
+// Frames the output thread ran, 0 while motion is emitted on every update.
+EXTERN unsigned long long gamepadsOutputFrames();
+
+// Versions of the profile that compiled and that failed to, 0 without a profile.
+EXTERN unsigned long long gamepadsProfileLoads();
+
+EXTERN unsigned long long gamepadsProfileErrors();
+
+// Versions of the profile taken from the cache without parsing.
+EXTERN unsigned long long gamepadsProfileCached();
+
+// Focus changes that selected another rule, 0 without application profiles.
+EXTERN unsigned long long gamepadsProfileSwitches();
+
+// Probes of empty slots a hotplug backend made unnecessary, 0 for backends without hotplug.
+EXTERN unsigned long long gamepadsProbesAvoided();
+
+// Milliseconds from process launch to the end of the first gamepadsUpdate(), 0 before it.
+EXTERN double gamepadsStartupTime();
+
+// Longest gamepadsUpdate() so far in milliseconds.
+EXTERN double gamepadsTickMax();
+
+EXTERN unsigned long long gamepadsProbes();
+
+EXTERN unsigned long long gamepadsProbesDeferred();
+
+EXTERN unsigned long long gamepadsReaderDeltas();
+
+EXTERN unsigned long long gamepadsReaderDrops();
+
+EXTERN int gamepadsReaderDepth();
+
+EXTERN int gamepadsReaderDepthMax();
+
+// Writes latency and poll interval percentiles of every pad into szBuffer, safe to call while another thread updates.
+EXTERN int gamepadsStatistics(char* szBuffer, const int iSize);
+
+// Getters read a snapshot published after every update and commands are queued for the next update,
+// so one UI thread may call them while another thread updates.
+EXTERN int gamepadIndex(const int iId);
+
+EXTERN int gamepadIsConnected(const int iId);
+
+EXTERN int gamepadIsEnabled(const int iId);
 
-EXTERN int gamepadIsEnabled(const int iIndex);
+EXTERN void gamepadToggle(const int iId);
 
-EXTERN void gamepadToggle(const int iIndex);
+EXTERN void gamepadEnable(const int iId, const int bEnable);
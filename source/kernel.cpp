@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "kernel.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace gp
+{
+	namespace kernel
+	{
+		constexpr double dThumbMinimum = static_cast<double>(std::numeric_limits<std::int16_t>::min());
+		constexpr double dThumbRange = static_cast<double>(std::numeric_limits<std::int16_t>::max()) - dThumbMinimum;
+
+		inline double normalizeThumb(const std::int16_t sValue)
+		{
+			return 2.0 * (static_cast<double>(sValue) - dThumbMinimum) / dThumbRange - 1.0;
+		}
+
+		void deadzone(const std::int16_t* pX, const std::int16_t* pY, const double* pThreshold, const double* pSpeed, double* pOutputX, double* pOutputY, double* pDeadzoned, const std::size_t szCount)
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				const double dValueX = normalizeThumb(pX[i]);
+				const double dValueY = normalizeThumb(pY[i]);
+
+				const double dLength = std::sqrt(dValueX * dValueX + dValueY * dValueY);
+				const double dDeadzonedLength = std::max(0.0, dLength - pThreshold[i]);
+
+				pDeadzoned[i] = dDeadzonedLength;
+
+				if (dDeadzonedLength > 0.0)
+				{
+					const double dFactor = dDeadzonedLength / dLength / (1.0 - pThreshold[i]);
+
+					pOutputX[i] = pSpeed[i] * dValueX * dFactor;
+					pOutputY[i] = pSpeed[i] * dValueY * dFactor;
+				}
+				else
+				{
+					pOutputX[i] = 0.0;
+					pOutputY[i] = 0.0;
+				}
+			}
+		}
+
+		// Bitwise square root, slow but exact, it only fills the seed table of isqrt().
+		std::uint32_t isqrtBitwise(std::uint32_t uValue)
+		{
+			std::uint32_t uRoot = 0;
+
+			for (std::uint32_t uBit = 1u << 30; uBit; uBit >>= 2)
+			{
+				if (uValue >= uRoot + uBit)
+				{
+					uValue -= uRoot + uBit;
+					uRoot = (uRoot >> 1) + uBit;
+				}
+				else
+				{
+					uRoot >>= 1;
+				}
+			}
+
+			return uRoot;
+		}
+
+		// Square roots of the top 8 bits with 4 fraction bits, taken at the middle of every step.
+		const std::array<std::uint16_t, 256> wSqrtSeeds = [] {
+			std::array<std::uint16_t, 256> wSeeds = {};
+
+			for (std::uint32_t i = 0; i < wSeeds.size(); i++)
+			{
+				wSeeds[i] = static_cast<std::uint16_t>(isqrtBitwise((i << 8) + 128));
+			}
+
+			return wSeeds;
+		}();
+
+		std::uint32_t isqrt(const std::uint32_t uValue)
+		{
+			if (uValue == 0)
+			{
+				return 0;
+			}
+
+			// An 8 bit seed from the table and one Newton step land within a step or two of the root.
+			const int iWidth = std::bit_width(uValue);
+			const int iShift = iWidth > 8 ? (iWidth - 7) & ~1 : 0;
+
+			std::uint32_t uRoot = std::max<std::uint32_t>((static_cast<std::uint32_t>(wSqrtSeeds[uValue >> iShift]) << (iShift / 2)) >> 4, 1);
+
+			uRoot = (uRoot + uValue / uRoot) >> 1;
+
+			while (static_cast<std::uint64_t>(uRoot) * uRoot > uValue)
+			{
+				uRoot--;
+			}
+
+			while ((static_cast<std::uint64_t>(uRoot) + 1) * (static_cast<std::uint64_t>(uRoot) + 1) <= uValue)
+			{
+				uRoot++;
+			}
+
+			return uRoot;
+		}
+
+		void deadzone(const std::int16_t* pX, const std::int16_t* pY, const std::int32_t* pThreshold, const std::int32_t* pInverse, const std::int32_t* pSpeed, const Curve* const* pCurves, std::int32_t* pOutputX, std::int32_t* pOutputY, std::int32_t* pDeflection, const std::size_t szCount)
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				const std::int32_t iX = pX[i];
+				const std::int32_t iY = pY[i];
+
+				// Thumbs are read as fractions of 32768, both squares together still fit 32 bits unsigned.
+				const std::int32_t iLength = static_cast<std::int32_t>(isqrt(static_cast<std::uint32_t>(iX * iX) + static_cast<std::uint32_t>(iY * iY)));
+				const std::int32_t iDeadzoned = iLength - pThreshold[i];
+
+				if (iDeadzoned <= 0)
+				{
+					pOutputX[i] = 0;
+					pOutputY[i] = 0;
+
+					pDeflection[i] = 0;
+
+					continue;
+				}
+
+				const std::int32_t iDeflection = static_cast<std::int32_t>((static_cast<std::int64_t>(iDeadzoned) * pInverse[i]) >> 16);
+
+				// One 32 bit division per lane, small cores divide 64 bit values in software.
+				const std::int32_t iReciprocal = (1 << 30) / iLength;
+
+				const std::int64_t llDirectionX = (static_cast<std::int64_t>(iX) * iReciprocal) >> Curve::One;
+				const std::int64_t llDirectionY = (static_cast<std::int64_t>(iY) * iReciprocal) >> Curve::One;
+
+				const std::int64_t llMagnitude = (static_cast<std::int64_t>(pCurves[i] ? (*pCurves[i])(iDeflection) : iDeflection) * pSpeed[i]) >> Curve::One;
+
+				pOutputX[i] = static_cast<std::int32_t>(std::clamp<std::int64_t>((llDirectionX * llMagnitude) >> Curve::One, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()));
+				pOutputY[i] = static_cast<std::int32_t>(std::clamp<std::int64_t>((llDirectionY * llMagnitude) >> Curve::One, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()));
+
+				pDeflection[i] = iDeflection;
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "curve.hpp"
+
+namespace gp
+{
+	namespace kernel
+	{
+		// Normalizes the raw thumb values and cuts the deadzone in the same pass.
+		extern void deadzone(const std::int16_t* pX, const std::int16_t* pY, const double* pThreshold, const double* pSpeed, double* pOutputX, double* pOutputY, double* pDeadzoned, const std::size_t szCount);
+
+		extern std::uint32_t isqrt(std::uint32_t uValue);
+
+		// Integer only variant that works on the raw thumb values, thresholds and deflections use Curve::One fraction bits,
+		// 1 / (1 - threshold), speeds and outputs 16. Curves are applied here already and the curve value times the speed has to stay below 131072.
+		extern void deadzone(const std::int16_t* pX, const std::int16_t* pY, const std::int32_t* pThreshold, const std::int32_t* pInverse, const std::int32_t* pSpeed, const Curve* const* pCurves, std::int32_t* pOutputX, std::int32_t* pOutputY, std::int32_t* pDeflection, const std::size_t szCount);
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "momentum.hpp"
+
+#include <cmath>
+
+namespace mouse
+{
+	namespace
+	{
+		void follow(double& dSpeed, const double dInput)
+		{
+			if (dInput * dSpeed < 0.0)
+			{
+				dSpeed = 0.0;
+			}
+
+			if (std::abs(dInput) >= std::abs(dSpeed))
+			{
+				dSpeed = dInput;
+			}
+		}
+	}
+
+	Momentum::Momentum(const Inertia& inertia) :
+		inertia(inertia), dDecay(std::exp(-inertia.dFriction * Step))
+	{
+
+	}
+
+	bool Momentum::isEnabled() const
+	{
+		return this->inertia.dFriction > 0.0;
+	}
+
+	bool Momentum::isMoving() const
+	{
+		return this->dx != 0.0 || this->dy != 0.0;
+	}
+
+	double Momentum::x() const
+	{
+		return this->dx;
+	}
+
+	double Momentum::y() const
+	{
+		return this->dy;
+	}
+
+	void Momentum::input(const double dx, const double dy)
+	{
+		this->dInputX = dx;
+		this->dInputY = dy;
+	}
+
+	void Momentum::advance(double& dx, double& dy, const double dElapsed)
+	{
+		dx = 0.0;
+		dy = 0.0;
+
+		if (!this->isMoving() && this->dInputX == 0.0 && this->dInputY == 0.0)
+		{
+			this->dTime = 0.0;
+
+			return;
+		}
+
+		this->dTime += dElapsed;
+
+		while (this->dTime >= Step)
+		{
+			this->dTime -= Step;
+
+			this->dx *= this->dDecay;
+			this->dy *= this->dDecay;
+
+			follow(this->dx, this->dInputX);
+			follow(this->dy, this->dInputY);
+
+			if (this->dInputX == 0.0 && this->dInputY == 0.0 && this->dx * this->dx + this->dy * this->dy < this->inertia.dStop * this->inertia.dStop)
+			{
+				this->dx = 0.0;
+				this->dy = 0.0;
+			}
+
+			dx += this->dx * Step;
+			dy += this->dy * Step;
+		}
+
+		this->dInputX = 0.0;
+		this->dInputY = 0.0;
+	}
+
+	void Momentum::stop()
+	{
+		this->dx = 0.0;
+		this->dy = 0.0;
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+namespace mouse
+{
+	struct Inertia
+	{
+		// Rate in 1/s at which the speed of a released binding decays exponentially, 0 turns momentum off.
+		double dFriction = 0.0;
+
+		// Below this speed in units per second the motion stops.
+		double dStop = 20.0;
+	};
+
+	// Keeps a motion binding going after its input returns to rest, integrated in fixed steps so the glide does not depend on the poll rate.
+	// Input in the direction of the motion speeds it up when it is faster than the glide, input against it stops the glide at once.
+	class Momentum
+	{
+	private:
+		Inertia inertia;
+
+		double dDecay = 1.0;
+
+		double dInputX = 0.0;
+		double dInputY = 0.0;
+
+		double dx = 0.0;
+		double dy = 0.0;
+
+		double dTime = 0.0;
+
+	public:
+		static constexpr double Step = 0.001;
+
+		Momentum(const Inertia& inertia = Inertia());
+
+		bool isEnabled() const;
+
+		bool isMoving() const;
+
+		double x() const;
+
+		double y() const;
+
+		// Speed the binding asks for in this tick, in units per second.
+		void input(const double dx, const double dy);
+
+		// Integrates the input of this tick over dElapsed seconds and returns the distance in dx and dy.
+		void advance(double& dx, double& dy, const double dElapsed);
+
+		void stop();
+	};
+}
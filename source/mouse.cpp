@@ -23,195 +23,165 @@
  */
 
 #include "mouse.hpp"
-
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
+#include "output.hpp"
 
 namespace mouse
 {
-	void moveX(const double dx)
+	namespace
 	{
-		static double dxRemainder = 0.0;
-
-		dxRemainder += dx;
+		Remainder moveRemainder;
+		Remainder scrollRemainder;
 
-		if (dxRemainder != 0.0)
+		int whole(double& dRemainder, const double dValue)
 		{
-			INPUT input;
+			dRemainder += dValue;
 
-			ZeroMemory(&input, sizeof(input));
+			const int iValue = static_cast<int>(dRemainder);
 
-			input.type = INPUT_MOUSE;
+			dRemainder -= static_cast<double>(iValue);
 
-			input.mi.dx = static_cast<LONG>(dxRemainder);
-			input.mi.dwFlags = MOUSEEVENTF_MOVE;
-
-			dxRemainder -= static_cast<double>(input.mi.dx);
-
-			SendInput(1, &input, sizeof(input));
+			return iValue;
 		}
 	}
 
-	void moveY(const double dy)
+	void motion(const Motion::Name motion, Remainder& remainder, const double dx, const double dy)
 	{
-		static double dyRemainder = 0.0;
+		switch (motion)
+		{
+		case Motion::Move:
+		{
+			const int iX = whole(remainder.dx, dx);
+			const int iY = whole(remainder.dy, -dy);
 
-		dyRemainder += dy;
+			output::push({ output::Event::Move, 0, iX, iY });
 
-		if (dyRemainder != 0.0)
+			break;
+		}
+		case Motion::MoveX:
 		{
-			INPUT input;
+			output::push({ output::Event::Move, 0, whole(remainder.dx, dx), 0 });
 
-			ZeroMemory(&input, sizeof(input));
+			break;
+		}
+		case Motion::MoveY:
+		{
+			output::push({ output::Event::Move, 0, 0, whole(remainder.dy, -dy) });
 
-			input.type = INPUT_MOUSE;
+			break;
+		}
+		case Motion::Scroll:
+		{
+			const int iX = whole(remainder.dx, dx);
+			const int iY = whole(remainder.dy, dy);
 
-			input.mi.dy = static_cast<LONG>(dyRemainder);
-			input.mi.dwFlags = MOUSEEVENTF_MOVE;
+			output::push({ output::Event::Scroll, 0, iX, iY });
 
-			dyRemainder -= static_cast<double>(input.mi.dy);
+			break;
+		}
+		case Motion::ScrollX:
+		{
+			output::push({ output::Event::Scroll, 0, whole(remainder.dx, dx), 0 });
 
-			SendInput(1, &input, sizeof(input));
+			break;
+		}
+		case Motion::ScrollY:
+		{
+			output::push({ output::Event::Scroll, 0, 0, whole(remainder.dy, dy) });
+
+			break;
+		}
+		default:
+		{
+			break;
+		}
 		}
 	}
 
-	void move(const double dx, const double dy)
+	output::Velocity channels(const Motion::Name motion, const double dx, const double dy)
 	{
-		static double dxRemainder = 0.0;
-		static double dyRemainder = 0.0;
-		
-		dxRemainder += dx;
-		dyRemainder -= dy;
-
-		if (dxRemainder != 0.0 || dyRemainder != 0.0)
+		switch (motion)
+		{
+		case Motion::Move:
+		{
+			return { dx, -dy, 0.0, 0.0 };
+		}
+		case Motion::MoveX:
+		{
+			return { dx, 0.0, 0.0, 0.0 };
+		}
+		case Motion::MoveY:
+		{
+			return { 0.0, -dy, 0.0, 0.0 };
+		}
+		case Motion::Scroll:
+		{
+			return { 0.0, 0.0, dx, dy };
+		}
+		case Motion::ScrollX:
+		{
+			return { 0.0, 0.0, dx, 0.0 };
+		}
+		case Motion::ScrollY:
+		{
+			return { 0.0, 0.0, 0.0, dy };
+		}
+		default:
 		{
-			INPUT input;
+			return {};
+		}
+		}
+	}
 
-			ZeroMemory(&input, sizeof(input));
+	void velocity(const Motion::Name motion, const double dx, const double dy)
+	{
+		output::velocity(channels(motion, dx, dy));
+	}
 
-			input.type = INPUT_MOUSE;
+	void moveX(const double dx)
+	{
+		motion(Motion::MoveX, moveRemainder, dx, 0.0);
+	}
 
-			input.mi.dx = static_cast<LONG>(dxRemainder);
-			input.mi.dy = static_cast<LONG>(dyRemainder);
-			input.mi.dwFlags = MOUSEEVENTF_MOVE;
+	void moveY(const double dy)
+	{
+		motion(Motion::MoveY, moveRemainder, 0.0, -dy);
+	}
 
-			dxRemainder -= static_cast<double>(input.mi.dx);
-			dyRemainder -= static_cast<double>(input.mi.dy);
+	void move(const double dx, const double dy)
+	{
+		motion(Motion::Move, moveRemainder, dx, dy);
+	}
 
-			SendInput(1, &input, sizeof(input));
-		}
+	void reset()
+	{
+		moveRemainder = Remainder();
+		scrollRemainder = Remainder();
 	}
 
 	void press(const Button::Name button)
 	{
-		static const DWORD dwFlagMap[] = {
-			MOUSEEVENTF_LEFTDOWN,
-			MOUSEEVENTF_MIDDLEDOWN,
-			MOUSEEVENTF_RIGHTDOWN,
-			MOUSEEVENTF_XDOWN,
-			MOUSEEVENTF_XDOWN,
-		};
-
-		static const DWORD dwDataMap[] = {
-			0,
-			0,
-			0,
-			XBUTTON1,
-			XBUTTON2,
-		};
-
 		if (button < Button::Count)
 		{
-			INPUT input;
-
-			ZeroMemory(&input, sizeof(input));
-
-			input.type = INPUT_MOUSE;
-
-			input.mi.dwFlags = dwFlagMap[button];
-			input.mi.mouseData = dwDataMap[button];
-
-			SendInput(1, &input, sizeof(input));
+			output::push({ output::Event::ButtonPress, button });
 		}
 	}
 
 	void release(const Button::Name button)
 	{
-		static const DWORD dwFlagMap[] = {
-			MOUSEEVENTF_LEFTUP,
-			MOUSEEVENTF_MIDDLEUP,
-			MOUSEEVENTF_RIGHTUP,
-			MOUSEEVENTF_XUP,
-			MOUSEEVENTF_XUP,
-		};
-
-		static const DWORD dwDataMap[] = {
-			0,
-			0,
-			0,
-			XBUTTON1,
-			XBUTTON2,
-		};
-
 		if (button < Button::Count)
 		{
-			INPUT input;
-
-			ZeroMemory(&input, sizeof(input));
-
-			input.type = INPUT_MOUSE;
-
-			input.mi.dwFlags = dwFlagMap[button];
-			input.mi.mouseData = dwDataMap[button];
-
-			SendInput(1, &input, sizeof(input));
+			output::push({ output::Event::ButtonRelease, button });
 		}
 	}
 
 	void scrollX(const double dx)
 	{
-		static double dxRemainder = 0.0;
-
-		dxRemainder += dx;
-
-		if (dxRemainder != 0.0)
-		{
-			INPUT input;
-
-			ZeroMemory(&input, sizeof(input));
-
-			input.type = INPUT_MOUSE;
-
-			input.mi.mouseData = static_cast<DWORD>(dxRemainder);
-			input.mi.dwFlags = MOUSEEVENTF_HWHEEL;
-
-			dxRemainder -= static_cast<double>(input.mi.mouseData);
-
-			SendInput(1, &input, sizeof(input));
-		}
+		motion(Motion::ScrollX, scrollRemainder, dx, 0.0);
 	}
 
 	void scrollY(const double dy)
 	{
-		static double dyRemainder = 0.0;
-
-		dyRemainder += dy;
-
-		if (dyRemainder != 0.0)
-		{
-			INPUT input;
-
-			ZeroMemory(&input, sizeof(input));
-
-			input.type = INPUT_MOUSE;
-
-			input.mi.mouseData = static_cast<DWORD>(dyRemainder);
-			input.mi.dwFlags = MOUSEEVENTF_WHEEL;
-
-			dyRemainder -= static_cast<double>(input.mi.mouseData);
-
-			SendInput(1, &input, sizeof(input));
-		}
+		motion(Motion::ScrollY, scrollRemainder, 0.0, dy);
 	}
 
 	void scroll(const double dx, const double dy)
@@ -227,27 +197,27 @@ namespace mouse
 		{
 		case Scroll::Left:
 		{
-			scrollX(-static_cast<double>(WHEEL_DELTA));
+			scrollX(-static_cast<double>(Scroll::Delta));
 
 			break;
 		}
 
 		case Scroll::Right:
 		{
-			scrollX(static_cast<double>(WHEEL_DELTA));
+			scrollX(static_cast<double>(Scroll::Delta));
 
 			break;
 		}
 		case Scroll::Up:
 		{
-			scrollY(static_cast<double>(WHEEL_DELTA));
+			scrollY(static_cast<double>(Scroll::Delta));
 
 			break;
 		}
 
 		case Scroll::Down:
 		{
-			scrollY(-static_cast<double>(WHEEL_DELTA));
+			scrollY(-static_cast<double>(Scroll::Delta));
 
 			break;
 		}
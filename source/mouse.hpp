@@ -24,14 +24,49 @@
 
 #pragma once
 
+#include "output.hpp"
+
 namespace mouse
 {
+	// Sub-pixel part of a motion that has not been sent yet, every binding that moves or scrolls keeps its own.
+	struct Remainder
+	{
+		double dx = 0.0;
+		double dy = 0.0;
+	};
+
+	struct Motion
+	{
+		typedef enum : unsigned int
+		{
+			Move,
+			MoveX,
+			MoveY,
+			Scroll,
+			ScrollX,
+			ScrollY,
+			Count
+		} Name;
+	};
+
+	// Sends the whole part of dx and dy plus the remainder, dy points up like the sticks and X and Y variants ignore the other component.
+	extern void motion(const Motion::Name motion, Remainder& remainder, const double dx, const double dy);
+
+	// Splits a motion into cursor and wheel components the way motion() sends it.
+	extern output::Velocity channels(const Motion::Name motion, const double dx, const double dy);
+
+	// Hands the speed of a motion in units per second to the output thread instead of moving, see output::glide().
+	extern void velocity(const Motion::Name motion, const double dx, const double dy);
+
 	extern void moveX(const double dx);
 	
 	extern void moveY(const double dy);
 
 	extern void move(const double dx, const double dy);
 
+	// Drops the sub-pixel remainders of the functions above, replays call this so every run starts from the same state.
+	extern void reset();
+
 	struct Button
 	{
 		typedef enum : unsigned int
@@ -59,6 +94,9 @@ namespace mouse
 			Down,
 			Count
 		} Name;
+
+		// Scroll motion is counted in 1/120 notch, sinks pass it on as high resolution wheel motion.
+		static constexpr int Delta = 120;
 	};
 
 	extern void scrollX(const double dx);
@@ -0,0 +1,374 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "output.hpp"
+#include "glide.hpp"
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace output
+{
+	SinkPtr pSink = nullptr;
+
+	bool bSinkCreated = false;
+
+	struct Stamp
+	{
+		stats::Histogram* pLatency = nullptr;
+
+		std::chrono::steady_clock::time_point tSample;
+	};
+
+	std::vector<Event> vEvents;
+	std::vector<Stamp> vStamps;
+
+	Stamp stampCurrent;
+
+	// Wheel motion of every binding is summed into the last Scroll event in units of 1/120 notch, until a key or button
+	// event follows it and the next wheel motion has to start a new one to stay in order with the presses and releases.
+	std::size_t szScroll = 0;
+
+	bool bScrolled = false;
+
+	Statistics statisticsLocal;
+
+	std::atomic<unsigned long long> ullQueued = 0;
+	std::atomic<unsigned long long> ullCoalesced = 0;
+	std::atomic<unsigned long long> ullSyscalls = 0;
+
+	// The output thread and commit() take turns on the sink.
+	std::mutex sinkLock;
+
+	std::mutex glideLock;
+
+	Glide glideState;
+
+	Velocity velocityTick;
+
+	bool bGliding = false;
+
+	std::atomic<bool> bGlideRun = false;
+
+	std::thread glideThread;
+
+	std::atomic<unsigned long long> ullGlideSyscalls = 0;
+	std::atomic<unsigned long long> ullFrames = 0;
+
+	void run(const int iRate)
+	{
+#ifdef _WIN32
+		HANDLE hTimer = CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+		if (!hTimer)
+		{
+			hTimer = CreateWaitableTimer(NULL, TRUE, NULL);
+		}
+#endif
+
+		const std::chrono::nanoseconds nsPeriod(1000000000ll / iRate);
+
+		std::chrono::steady_clock::time_point tNext = std::chrono::steady_clock::now();
+
+		Event events[2];
+
+		while (bGlideRun.load(std::memory_order_acquire))
+		{
+			tNext += nsPeriod;
+
+			const std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+			// Frames that were missed are dropped, the next frame carries their motion.
+			if (tNext < tNow)
+			{
+				tNext = tNow;
+			}
+
+#ifdef _WIN32
+			LARGE_INTEGER liDueTime;
+
+			liDueTime.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(tNext - tNow).count() / 100);
+
+			if (hTimer && liDueTime.QuadPart < 0 && SetWaitableTimer(hTimer, &liDueTime, 0, NULL, NULL, FALSE))
+			{
+				WaitForSingleObject(hTimer, INFINITE);
+			}
+			else
+			{
+				std::this_thread::sleep_until(tNext);
+			}
+#else
+			std::this_thread::sleep_until(tNext);
+#endif
+
+			std::size_t szCount = 0;
+
+			{
+				std::lock_guard<std::mutex> lock(glideLock);
+
+				szCount = glideState.frame(std::chrono::steady_clock::now(), events);
+			}
+
+			if (szCount > 0)
+			{
+				std::lock_guard<std::mutex> lock(sinkLock);
+
+				if (pSink)
+				{
+					pSink->commit(events, szCount);
+
+					ullGlideSyscalls.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			ullFrames.fetch_add(1, std::memory_order_relaxed);
+		}
+
+#ifdef _WIN32
+		if (hTimer)
+		{
+			CloseHandle(hTimer);
+		}
+#endif
+	}
+
+	bool isEmpty(const Event& event)
+	{
+		return (event.type == Event::Move || event.type == Event::Scroll) && event.iX == 0 && event.iY == 0;
+	}
+
+	SinkPtr makeSink()
+	{
+#ifdef _WIN32
+		return makeSendInputSink();
+#else
+		return makeUinputSink();
+#endif
+	}
+
+	void setSink(const SinkPtr& pSink)
+	{
+		std::lock_guard<std::mutex> lock(sinkLock);
+
+		output::pSink = pSink;
+
+		bSinkCreated = true;
+	}
+
+	void source(stats::Histogram* pLatency, const std::chrono::steady_clock::time_point tSample)
+	{
+		stampCurrent = { pLatency, tSample };
+	}
+
+	// Drops the open Scroll event if its motion cancelled out and closes it.
+	void settle()
+	{
+		if (bScrolled && isEmpty(vEvents[szScroll]))
+		{
+			vEvents.erase(vEvents.begin() + szScroll);
+			vStamps.erase(vStamps.begin() + szScroll);
+
+			statisticsLocal.ullCoalesced++;
+		}
+
+		bScrolled = false;
+	}
+
+	void push(const Event& event)
+	{
+		statisticsLocal.ullQueued++;
+
+		if (isEmpty(event))
+		{
+			statisticsLocal.ullCoalesced++;
+
+			return;
+		}
+
+		if (event.type == Event::Scroll && bScrolled)
+		{
+			vEvents[szScroll].iX += event.iX;
+			vEvents[szScroll].iY += event.iY;
+
+			statisticsLocal.ullCoalesced++;
+
+			return;
+		}
+
+		if (event.type != Event::Move && event.type != Event::Scroll)
+		{
+			settle();
+		}
+
+		if (!vEvents.empty() && vEvents.back().type == event.type && event.type == Event::Move)
+		{
+			Event& last = vEvents.back();
+
+			last.iX += event.iX;
+			last.iY += event.iY;
+
+			statisticsLocal.ullCoalesced++;
+
+			if (isEmpty(last))
+			{
+				vEvents.pop_back();
+				vStamps.pop_back();
+
+				statisticsLocal.ullCoalesced++;
+			}
+
+			return;
+		}
+
+		if (vEvents.capacity() == 0)
+		{
+			vEvents.reserve(64);
+			vStamps.reserve(64);
+		}
+
+		if (event.type == Event::Scroll)
+		{
+			szScroll = vEvents.size();
+
+			bScrolled = true;
+		}
+
+		vEvents.push_back(event);
+		vStamps.push_back(stampCurrent);
+	}
+
+	void commit()
+	{
+		settle();
+
+		if (!vEvents.empty())
+		{
+			if (!bSinkCreated)
+			{
+				setSink(makeSink());
+			}
+
+			if (pSink)
+			{
+				{
+					std::lock_guard<std::mutex> lock(sinkLock);
+
+					pSink->commit(vEvents.data(), vEvents.size());
+				}
+
+				statisticsLocal.ullSyscalls++;
+
+				const std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+				for (const Stamp& stamp : vStamps)
+				{
+					if (stamp.pLatency)
+					{
+						stamp.pLatency->record(tNow - stamp.tSample);
+					}
+				}
+			}
+
+			vEvents.clear();
+			vStamps.clear();
+		}
+
+		if (bGliding)
+		{
+			std::lock_guard<std::mutex> lock(glideLock);
+
+			glideState.sample(velocityTick, std::chrono::steady_clock::now());
+
+			velocityTick = Velocity();
+		}
+
+		ullQueued.store(statisticsLocal.ullQueued, std::memory_order_relaxed);
+		ullCoalesced.store(statisticsLocal.ullCoalesced, std::memory_order_relaxed);
+		ullSyscalls.store(statisticsLocal.ullSyscalls, std::memory_order_relaxed);
+	}
+
+	Statistics statistics()
+	{
+		Statistics statistics;
+
+		statistics.ullQueued = ullQueued.load(std::memory_order_relaxed);
+		statistics.ullCoalesced = ullCoalesced.load(std::memory_order_relaxed);
+		statistics.ullSyscalls = ullSyscalls.load(std::memory_order_relaxed) + ullGlideSyscalls.load(std::memory_order_relaxed);
+		statistics.ullFrames = ullFrames.load(std::memory_order_relaxed);
+
+		return statistics;
+	}
+
+	void glide(const int iRate)
+	{
+		if (glideThread.joinable())
+		{
+			bGlideRun.store(false, std::memory_order_release);
+
+			glideThread.join();
+		}
+
+		bGliding = iRate > 0;
+
+		velocityTick = Velocity();
+
+		glideState.reset();
+
+		if (bGliding)
+		{
+			if (!bSinkCreated)
+			{
+				setSink(makeSink());
+			}
+
+			bGlideRun.store(true, std::memory_order_release);
+
+			glideThread = std::thread(run, iRate);
+		}
+	}
+
+	bool isGliding()
+	{
+		return bGliding;
+	}
+
+	void velocity(const Velocity& velocity)
+	{
+		velocityTick.dMoveX += velocity.dMoveX;
+		velocityTick.dMoveY += velocity.dMoveY;
+		velocityTick.dScrollX += velocity.dScrollX;
+		velocityTick.dScrollY += velocity.dScrollY;
+	}
+}
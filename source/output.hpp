@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "stats.hpp"
+
+namespace output
+{
+	struct Event
+	{
+		typedef enum : unsigned int
+		{
+			Move,
+			Scroll,
+			ButtonPress,
+			ButtonRelease,
+			KeyPress,
+			KeyRelease,
+			Count
+		} Type;
+
+		Type type = Move;
+
+		unsigned int uCode = 0;
+
+		int iX = 0;
+		int iY = 0;
+	};
+
+	class Sink
+	{
+	public:
+		virtual ~Sink() = default;
+
+		virtual void commit(const Event* pEvents, const std::size_t szCount) = 0;
+	};
+
+	typedef std::shared_ptr<Sink> SinkPtr;
+
+	// Cursor and wheel speed in pixels and wheel units per second, Y points down like the screen and up for the wheel.
+	struct Velocity
+	{
+		double dMoveX = 0.0;
+		double dMoveY = 0.0;
+		double dScrollX = 0.0;
+		double dScrollY = 0.0;
+	};
+
+	struct Statistics
+	{
+		unsigned long long ullQueued = 0;
+		unsigned long long ullCoalesced = 0;
+		unsigned long long ullSyscalls = 0;
+		unsigned long long ullFrames = 0;
+	};
+
+	extern SinkPtr makeSendInputSink();
+
+	extern SinkPtr makeUinputSink();
+
+	extern SinkPtr makeSink();
+
+	extern void setSink(const SinkPtr& pSink);
+
+	// Events pushed from now on stem from a sample taken at tSample, commit() records their age into pLatency once they are injected.
+	extern void source(stats::Histogram* pLatency, const std::chrono::steady_clock::time_point tSample);
+
+	extern void push(const Event& event);
+
+	extern void commit();
+
+	// Emits cursor and wheel motion from its own thread iRate times per second, 0 stops the thread and motion goes through push() again.
+	// Call it from the thread that commits, or before that thread starts.
+	extern void glide(const int iRate);
+
+	extern bool isGliding();
+
+	// Adds to the velocity of the current tick, commit() hands the sum over to the output thread.
+	extern void velocity(const Velocity& velocity);
+
+	extern Statistics statistics();
+}
@@ -0,0 +1,272 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pads.hpp"
+#include "kernel.hpp"
+
+namespace gp
+{
+	Pads::Id Pads::add(const GamepadPtr& gamepad)
+	{
+		std::uint32_t uSlot = 0;
+
+		if (this->vFree.empty())
+		{
+			uSlot = static_cast<std::uint32_t>(this->vSlots.size());
+
+			this->vSlots.push_back(Slot());
+		}
+		else
+		{
+			uSlot = this->vFree.back();
+
+			this->vFree.pop_back();
+		}
+
+		Slot& slot = this->vSlots[uSlot];
+
+		slot.uPosition = static_cast<std::uint32_t>(this->vGamepads.size());
+
+		const Id id = ((slot.uGeneration & 0x7FFF) << 16) | uSlot;
+
+		this->vGamepads.push_back(gamepad);
+		this->vIds.push_back(id);
+
+		this->resize();
+
+		return id;
+	}
+
+	bool Pads::remove(const Id id)
+	{
+		const std::size_t szPosition = this->find(id);
+
+		if (szPosition == this->size())
+		{
+			return false;
+		}
+
+		const std::size_t szLast = this->size() - 1;
+
+		if (szPosition != szLast)
+		{
+			this->vGamepads[szPosition] = std::move(this->vGamepads[szLast]);
+			this->vIds[szPosition] = this->vIds[szLast];
+
+			this->vSlots[this->vIds[szPosition] & 0xFFFF].uPosition = static_cast<std::uint32_t>(szPosition);
+		}
+
+		this->vGamepads.pop_back();
+		this->vIds.pop_back();
+
+		this->vSlots[id & 0xFFFF].uGeneration++;
+		this->vFree.push_back(id & 0xFFFF);
+
+		this->resize();
+
+		return true;
+	}
+
+	void Pads::resize()
+	{
+		const std::size_t szCount = this->vGamepads.size();
+
+		this->vStates.resize(szCount);
+		this->vPolled.resize(szCount);
+		this->vNormalized.resize(szCount);
+		this->vLaneOffsets.resize(szCount + 1);
+	}
+
+	void Pads::clear()
+	{
+		*this = Pads();
+	}
+
+	std::size_t Pads::size() const
+	{
+		return this->vGamepads.size();
+	}
+
+	const GamepadPtr& Pads::operator[](const std::size_t szPosition) const
+	{
+		return this->vGamepads[szPosition];
+	}
+
+	Pads::Id Pads::id(const std::size_t szPosition) const
+	{
+		return szPosition < this->vIds.size() ? this->vIds[szPosition] : Invalid;
+	}
+
+	std::size_t Pads::find(const Id id) const
+	{
+		const std::size_t szSlot = id & 0xFFFF;
+
+		if (szSlot >= this->vSlots.size())
+		{
+			return this->size();
+		}
+
+		const Slot& slot = this->vSlots[szSlot];
+
+		if (slot.uPosition >= this->vIds.size() || this->vIds[slot.uPosition] != id)
+		{
+			return this->size();
+		}
+
+		return slot.uPosition;
+	}
+
+	void Pads::batched(const bool bBatched)
+	{
+		this->bBatched = bBatched;
+	}
+
+	bool Pads::isBatched() const
+	{
+		return this->bBatched;
+	}
+
+	void Pads::fixed(const bool bFixed)
+	{
+		this->bFixed = bFixed;
+	}
+
+	bool Pads::isFixed() const
+	{
+		return this->bFixed;
+	}
+
+	void Pads::update()
+	{
+		const std::size_t szCount = this->vGamepads.size();
+
+		if (!this->bBatched && !this->bFixed)
+		{
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				this->vGamepads[i]->update();
+			}
+
+			return;
+		}
+
+		for (std::size_t i = 0; i < szCount; i++)
+		{
+			State& state = this->vStates[i];
+
+			this->vPolled[i] = this->vGamepads[i]->poll(state);
+
+			if (this->vPolled[i])
+			{
+				this->vNormalized[i] = normalize(state);
+			}
+			else
+			{
+				state = State();
+			}
+
+			this->vLaneOffsets[i + 1] = this->vLaneOffsets[i] + (this->vPolled[i] ? this->vGamepads[i]->lanes() : 0);
+		}
+
+		const std::size_t szLanes = this->vLaneOffsets[szCount];
+
+		this->vLaneX.resize(szLanes);
+		this->vLaneY.resize(szLanes);
+
+		if (this->bFixed)
+		{
+			this->vFixedThreshold.resize(szLanes);
+			this->vInverse.resize(szLanes);
+			this->vFixedSpeed.resize(szLanes);
+			this->vCurves.resize(szLanes);
+			this->vFixedX.resize(szLanes);
+			this->vFixedY.resize(szLanes);
+			this->vDeflection.resize(szLanes);
+
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (this->vPolled[i])
+				{
+					const std::size_t szOffset = this->vLaneOffsets[i];
+
+					this->vGamepads[i]->lanes(this->vStates[i], this->vLaneX.data() + szOffset, this->vLaneY.data() + szOffset, this->vFixedThreshold.data() + szOffset, this->vInverse.data() + szOffset, this->vFixedSpeed.data() + szOffset, this->vCurves.data() + szOffset);
+				}
+			}
+
+			kernel::deadzone(this->vLaneX.data(), this->vLaneY.data(), this->vFixedThreshold.data(), this->vInverse.data(), this->vFixedSpeed.data(), this->vCurves.data(), this->vFixedX.data(), this->vFixedY.data(), this->vDeflection.data(), szLanes);
+		}
+		else
+		{
+			this->vThreshold.resize(szLanes);
+			this->vSpeed.resize(szLanes);
+			this->vOutputX.resize(szLanes);
+			this->vOutputY.resize(szLanes);
+			this->vDeadzoned.resize(szLanes);
+
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				if (this->vPolled[i])
+				{
+					const std::size_t szOffset = this->vLaneOffsets[i];
+
+					this->vGamepads[i]->lanes(this->vStates[i], this->vLaneX.data() + szOffset, this->vLaneY.data() + szOffset, this->vThreshold.data() + szOffset, this->vSpeed.data() + szOffset);
+				}
+			}
+
+			kernel::deadzone(this->vLaneX.data(), this->vLaneY.data(), this->vThreshold.data(), this->vSpeed.data(), this->vOutputX.data(), this->vOutputY.data(), this->vDeadzoned.data(), szLanes);
+		}
+
+		this->process(this->bFixed);
+	}
+
+	void Pads::process(const bool bFixed)
+	{
+		const std::size_t szCount = this->vGamepads.size();
+
+		for (std::size_t i = 0; i < szCount; i++)
+		{
+			if (this->vPolled[i])
+			{
+				const std::size_t szOffset = this->vLaneOffsets[i];
+
+				Lanes lanes;
+
+				if (bFixed)
+				{
+					lanes.pFixedX = this->vFixedX.data() + szOffset;
+					lanes.pFixedY = this->vFixedY.data() + szOffset;
+					lanes.pDeflection = this->vDeflection.data() + szOffset;
+				}
+				else
+				{
+					lanes.pOutputX = this->vOutputX.data() + szOffset;
+					lanes.pOutputY = this->vOutputY.data() + szOffset;
+					lanes.pDeadzoned = this->vDeadzoned.data() + szOffset;
+				}
+
+				this->vGamepads[i]->process(this->vStates[i], this->vNormalized[i], &lanes);
+			}
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gamepad.hpp"
+
+namespace gp
+{
+	// Registry of any number of pads, iterated densely and addressed by ids that stay valid until their pad is removed.
+	class Pads
+	{
+	public:
+		// Low 16 bits select the slot, the high bits count how often the slot was reused.
+		typedef std::uint32_t Id;
+
+		static constexpr Id Invalid = 0xFFFFFFFF;
+
+	private:
+		struct Slot
+		{
+			std::uint32_t uGeneration = 0;
+			std::uint32_t uPosition = 0;
+		};
+
+		std::vector<Slot> vSlots;
+		std::vector<std::uint32_t> vFree;
+
+		std::vector<GamepadPtr> vGamepads;
+		std::vector<Id> vIds;
+
+		std::vector<State> vStates;
+		std::vector<std::uint8_t> vPolled;
+
+		std::vector<Normalized> vNormalized;
+
+		std::vector<std::size_t> vLaneOffsets;
+
+		std::vector<std::int16_t> vLaneX;
+		std::vector<std::int16_t> vLaneY;
+		std::vector<double> vThreshold;
+		std::vector<double> vSpeed;
+		std::vector<double> vOutputX;
+		std::vector<double> vOutputY;
+		std::vector<double> vDeadzoned;
+
+		bool bBatched = false;
+		bool bFixed = false;
+
+		std::vector<std::int32_t> vFixedThreshold;
+		std::vector<std::int32_t> vInverse;
+		std::vector<std::int32_t> vFixedSpeed;
+		std::vector<const Curve*> vCurves;
+		std::vector<std::int32_t> vFixedX;
+		std::vector<std::int32_t> vFixedY;
+		std::vector<std::int32_t> vDeflection;
+
+		void resize();
+
+		// Hands every polled pad its normalized axes and stick lanes.
+		void process(const bool bFixed);
+
+	public:
+		Id add(const GamepadPtr& gamepad);
+
+		// Moves the last pad into the freed position, other pads and their bindings stay where they are.
+		bool remove(const Id id);
+
+		void clear();
+
+		std::size_t size() const;
+
+		const GamepadPtr& operator[](const std::size_t szPosition) const;
+
+		Id id(const std::size_t szPosition) const;
+
+		// Position of the pad with this id or size() if there is none.
+		std::size_t find(const Id id) const;
+
+		// Polls every pad first and runs all stick lanes through one kernel call, off by default because each pad updating on its own
+		// measures faster in benchmark/kernel. The lanes stay for the fixed point path and as the layout a vector kernel would need.
+		void batched(const bool bBatched);
+
+		bool isBatched() const;
+
+		// Runs the sticks through the integer kernel instead of the double one, triggers stay in double. Implies batched lanes.
+		void fixed(const bool bFixed);
+
+		bool isFixed() const;
+
+		void update();
+	};
+}
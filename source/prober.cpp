@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "prober.hpp"
+
+#include <algorithm>
+
+namespace gp
+{
+	Prober::Prober(const BackendPtr& pBackend, const std::chrono::milliseconds msMin, const std::chrono::milliseconds msMax, const std::chrono::microseconds usBudget) :
+		pBackend(pBackend), msMin(msMin), msMax(std::max(msMax, msMin)), usBudget(usBudget)
+	{
+		const int iCount = this->pBackend->count();
+
+		const std::chrono::steady_clock::time_point tNow = this->pBackend->now();
+
+		this->vSlots.resize(static_cast<std::size_t>(std::max(iCount, 0)));
+
+		// The first probes are spread over one backoff interval already, so empty slots never line up on the same tick.
+		for (int iIndex = 0; iIndex < iCount; iIndex++)
+		{
+			this->vSlots[iIndex].tDue = tNow + this->msMin * iIndex / iCount;
+			this->vSlots[iIndex].msBackoff = this->msMin;
+		}
+	}
+
+	int Prober::count() const
+	{
+		return this->pBackend->count();
+	}
+
+	bool Prober::read(const int iIndex, State& state)
+	{
+		if (iIndex < 0 || static_cast<std::size_t>(iIndex) >= this->vSlots.size())
+		{
+			return false;
+		}
+
+		Slot& slot = this->vSlots[iIndex];
+
+		if (slot.bConnected)
+		{
+			if (this->pBackend->read(iIndex, state))
+			{
+				return true;
+			}
+
+			slot.bConnected = false;
+			slot.msBackoff = this->msMin;
+			slot.tDue = this->pBackend->now() + slot.msBackoff;
+
+			return false;
+		}
+
+		if (this->pBackend->now() < slot.tDue)
+		{
+			return false;
+		}
+
+		if (this->nsSpent >= this->usBudget)
+		{
+			this->ullDeferred.fetch_add(1, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		const bool bConnected = this->pBackend->read(iIndex, state);
+
+		this->nsSpent += std::chrono::steady_clock::now() - tStart;
+
+		this->ullProbes.fetch_add(1, std::memory_order_relaxed);
+
+		if (bConnected)
+		{
+			slot.bConnected = true;
+			slot.msBackoff = this->msMin;
+
+			return true;
+		}
+
+		slot.tDue = this->pBackend->now() + slot.msBackoff;
+		slot.msBackoff = std::min(slot.msBackoff * 2, this->msMax);
+
+		return false;
+	}
+
+	bool Prober::isConcurrent() const
+	{
+		return false;
+	}
+
+	bool Prober::isEventDriven() const
+	{
+		return this->pBackend->isEventDriven();
+	}
+
+	bool Prober::wait(const int iTimeout)
+	{
+		this->nsSpent = std::chrono::nanoseconds::zero();
+
+		return this->pBackend->wait(iTimeout);
+	}
+
+	void Prober::wake()
+	{
+		this->pBackend->wake();
+	}
+
+	bool Prober::isPaced() const
+	{
+		return true;
+	}
+
+	std::chrono::steady_clock::time_point Prober::now() const
+	{
+		return this->pBackend->now();
+	}
+
+	Prober::Statistics Prober::statistics() const
+	{
+		Statistics statistics;
+
+		statistics.ullProbes = this->ullProbes.load(std::memory_order_relaxed);
+		statistics.ullDeferred = this->ullDeferred.load(std::memory_order_relaxed);
+
+		return statistics;
+	}
+
+	ProberPtr makeProber(const BackendPtr& pBackend, const std::chrono::milliseconds msMin, const std::chrono::milliseconds msMax, const std::chrono::microseconds usBudget)
+	{
+		if (!pBackend)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<Prober>(pBackend, msMin, msMax, usBudget);
+	}
+}
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "backend.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gp
+{
+	// Paces probes of disconnected slots for backends where reading an empty slot is expensive.
+	// Every slot backs off exponentially while it stays empty and each tick, which starts at wait(), probes only until its budget is spent.
+	class Prober : public Backend
+	{
+	public:
+		struct Statistics
+		{
+			unsigned long long ullProbes = 0;
+			unsigned long long ullDeferred = 0;
+		};
+
+	private:
+		struct Slot
+		{
+			bool bConnected = false;
+
+			std::chrono::steady_clock::time_point tDue;
+
+			std::chrono::milliseconds msBackoff;
+		};
+
+		BackendPtr pBackend;
+
+		std::chrono::milliseconds msMin;
+		std::chrono::milliseconds msMax;
+
+		std::chrono::microseconds usBudget;
+
+		std::vector<Slot> vSlots;
+
+		// Time spent probing since the current tick started.
+		std::chrono::nanoseconds nsSpent = std::chrono::nanoseconds::zero();
+
+		std::atomic<unsigned long long> ullProbes = 0;
+		std::atomic<unsigned long long> ullDeferred = 0;
+
+	public:
+		Prober(const BackendPtr& pBackend, const std::chrono::milliseconds msMin, const std::chrono::milliseconds msMax, const std::chrono::microseconds usBudget);
+
+		int count() const override;
+
+		// Connected slots are read as usual, empty slots only when they are due and the tick still has budget left.
+		bool read(const int iIndex, State& state) override;
+
+		bool isConcurrent() const override;
+
+		bool isEventDriven() const override;
+
+		bool wait(const int iTimeout) override;
+
+		void wake() override;
+
+		bool isPaced() const override;
+
+		std::chrono::steady_clock::time_point now() const override;
+
+		Statistics statistics() const;
+	};
+
+	typedef std::shared_ptr<Prober> ProberPtr;
+
+	// The first probe of a tick always runs, so a budget smaller than a single probe still probes one slot per tick.
+	extern ProberPtr makeProber(const BackendPtr& pBackend, const std::chrono::milliseconds msMin = std::chrono::milliseconds(250), const std::chrono::milliseconds msMax = std::chrono::milliseconds(2000), const std::chrono::microseconds usBudget = std::chrono::microseconds(500));
+}
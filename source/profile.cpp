@@ -0,0 +1,1300 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "profile.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace gp
+{
+	namespace profile
+	{
+		namespace
+		{
+			const char* const szButtons[] = { "DpadUp", "DpadDown", "DpadLeft", "DpadRight", "Start", "Back", "ThumbLeft", "ThumbRight", "ShoulderLeft", "ShoulderRight", "A", "B", "X", "Y" };
+
+			static_assert(std::size(szButtons) == gp::Button::Count);
+
+			const char* const szAxes[] = { "TriggerLeft", "TriggerRight", "StickLeftX", "StickLeftY", "StickRightX", "StickRightY" };
+
+			static_assert(std::size(szAxes) == gp::Axis::Count);
+
+			const char* const szSticks[] = { "Left", "Right" };
+
+			static_assert(std::size(szSticks) == gp::Stick::Count);
+
+			const char* const szMouseButtons[] = { "Left", "Middle", "Right", "X1", "X2" };
+
+			static_assert(std::size(szMouseButtons) == mouse::Button::Count);
+
+			const char* const szScrolls[] = { "Left", "Right", "Up", "Down" };
+
+			static_assert(std::size(szScrolls) == mouse::Scroll::Count);
+
+			const char* const szMotions[] = { "Move", "MoveX", "MoveY", "Scroll", "ScrollX", "ScrollY" };
+
+			static_assert(std::size(szMotions) == mouse::Motion::Count);
+
+			const char* const szEvents[] = { "Enable", "Disable", "Toggle" };
+
+			static_assert(std::size(szEvents) == Gamepad::Event::Count);
+
+			const char* const szKeys[] =
+			{
+			"MouseButtonLeft",
+			"MouseButtonRight",
+			"Cancel",
+			"MouseButtonMiddle",
+			"MouseButtonX1",
+			"MouseButtonX2",
+			"Back",
+			"Tab",
+			"Clear",
+			"Return",
+			"Shift",
+			"Control",
+			"Menu",
+			"Pause",
+			"CapitalLock",
+			"IMEKana",
+			"IMEHanguel",
+			"IMEHangul",
+			"IMEOn",
+			"IMEJunja",
+			"IMEFinal",
+			"IMEHanja",
+			"IMEKanji",
+			"IMEOff",
+			"Escape",
+			"IMEConvert",
+			"IMENonConvert",
+			"IMEAccept",
+			"IMEModeChange",
+			"Space",
+			"Prior",
+			"Next",
+			"End",
+			"Home",
+			"Left",
+			"Up",
+			"Right",
+			"Down",
+			"Select",
+			"Print",
+			"Execute",
+			"Snapshot",
+			"Insert",
+			"Delete",
+			"Help",
+			"Num0",
+			"Num1",
+			"Num2",
+			"Num3",
+			"Num4",
+			"Num5",
+			"Num6",
+			"Num7",
+			"Num8",
+			"Num9",
+			"A",
+			"B",
+			"C",
+			"D",
+			"E",
+			"F",
+			"G",
+			"H",
+			"I",
+			"J",
+			"K",
+			"L",
+			"M",
+			"N",
+			"O",
+			"P",
+			"Q",
+			"R",
+			"S",
+			"T",
+			"U",
+			"V",
+			"W",
+			"X",
+			"Y",
+			"Z",
+			"WindowsLeft",
+			"WindowsRight",
+			"Applications",
+			"Sleep",
+			"NumPad0",
+			"NumPad1",
+			"NumPad2",
+			"NumPad3",
+			"NumPad4",
+			"NumPad5",
+			"NumPad6",
+			"NumPad7",
+			"NumPad8",
+			"NumPad9",
+			"Multiply",
+			"Add",
+			"Separator",
+			"Subtract",
+			"Decimal",
+			"Divide",
+			"F1",
+			"F2",
+			"F3",
+			"F4",
+			"F5",
+			"F6",
+			"F7",
+			"F8",
+			"F9",
+			"F10",
+			"F11",
+			"F12",
+			"F13",
+			"F14",
+			"F15",
+			"F16",
+			"F17",
+			"F18",
+			"F19",
+			"F20",
+			"F21",
+			"F22",
+			"F23",
+			"F24",
+			"NumLock",
+			"ScrollLock",
+			"ShiftLeft",
+			"ShiftRight",
+			"ControlLeft",
+			"ControlRight",
+			"MenuLeft",
+			"MenuRight",
+			"BrowserBack",
+			"BrowserForward",
+			"BrowserRefresh",
+			"BrowserStop",
+			"BrowserSearch",
+			"BrowserFavorites",
+			"BrowserHome",
+			"VolumeMute",
+			"VolumeDown",
+			"VolumeUp",
+			"MediaNextTrack",
+			"MediaPreviousTrack",
+			"MediaStop",
+			"MediaPlayPause",
+			"LaunchMail",
+			"LaunchMediaSelect",
+			"LaunchApplication1",
+			"LaunchApplication2",
+			"OEM1",
+			"OEMPlus",
+			"OEMComma",
+			"OEMMinus",
+			"OEMPeriod",
+			"OEM2",
+			"OEM3",
+			"OEM4",
+			"OEM5",
+			"OEM6",
+			"OEM7",
+			"OEM8",
+			"OEM102",
+			"ProcessKey",
+			"Packet",
+			"Attn",
+			"CrSel",
+			"ExSel",
+			"ErEOF",
+			"Play",
+			"Zoom",
+			"NoName",
+			"PA1",
+			"OEMClear"
+			};
+
+			static_assert(std::size(szKeys) == key::Key::Count);
+
+			void none()
+			{
+
+			}
+
+			const struct
+			{
+				const char* szName;
+
+				void(*fFunction)();
+			} calls[] = {
+				{ "OnScreenKeyboard", key::onScreenKeyboardToggle },
+				{ "OnScreenKeyboardOpen", key::onScreenKeyboardOpen },
+				{ "OnScreenKeyboardClose", key::onScreenKeyboardClose },
+				{ "SwitchWindows", key::switchWindows },
+				{ "TakeScreenshot", key::takeScreenshot }
+			};
+
+			template <const std::size_t szCount>
+			int find(const char* const (&szNames)[szCount], const std::string& sName)
+			{
+				for (std::size_t i = 0; i < szCount; i++)
+				{
+					if (sName == szNames[i])
+					{
+						return static_cast<int>(i);
+					}
+				}
+
+				return -1;
+			}
+
+			int findCall(const std::string& sName)
+			{
+				for (std::size_t i = 0; i < std::size(calls); i++)
+				{
+					if (sName == calls[i].szName)
+					{
+						return static_cast<int>(i);
+					}
+				}
+
+				return -1;
+			}
+
+			// Tokens of one line with the position of the next one to read, every failure names the line and the offending token.
+			class Line
+			{
+			private:
+				std::vector<std::string> vTokens;
+
+				std::size_t szPosition = 0;
+
+				std::uint32_t uLine = 0;
+
+				std::string& sError;
+
+			public:
+				Line(const std::string& sText, const std::uint32_t uLine, std::string& sError) :
+					uLine(uLine), sError(sError)
+				{
+					std::istringstream stream(sText.substr(0, sText.find('#')));
+
+					for (std::string sToken; stream >> sToken;)
+					{
+						this->vTokens.push_back(sToken);
+					}
+				}
+
+				bool isEmpty() const
+				{
+					return this->szPosition >= this->vTokens.size();
+				}
+
+				std::uint32_t line() const
+				{
+					return this->uLine;
+				}
+
+				const std::string& peek() const
+				{
+					static const std::string sEnd;
+
+					return this->isEmpty() ? sEnd : this->vTokens[this->szPosition];
+				}
+
+				std::string next()
+				{
+					return this->isEmpty() ? std::string() : this->vTokens[this->szPosition++];
+				}
+
+				bool fail(const std::string& sWhat)
+				{
+					this->sError = "line " + std::to_string(this->uLine) + ": " + sWhat;
+
+					return false;
+				}
+
+				template <const std::size_t szCount>
+				bool name(const char* const (&szNames)[szCount], const char* szWhat, std::uint32_t& uValue)
+				{
+					const std::string sToken = this->next();
+
+					const int iValue = find(szNames, sToken);
+
+					if (iValue < 0)
+					{
+						return this->fail(std::string("unknown ") + szWhat + " '" + sToken + "'");
+					}
+
+					uValue = static_cast<std::uint32_t>(iValue);
+
+					return true;
+				}
+
+				bool number(double& dValue)
+				{
+					const std::string sToken = this->next();
+
+					char* pEnd = nullptr;
+
+					dValue = std::strtod(sToken.c_str(), &pEnd);
+
+					if (sToken.empty() || *pEnd != '\0')
+					{
+						return this->fail("expected a number instead of '" + sToken + "'");
+					}
+
+					return true;
+				}
+
+				bool isNumber() const
+				{
+					const std::string& sToken = this->peek();
+
+					char* pEnd = nullptr;
+
+					std::strtod(sToken.c_str(), &pEnd);
+
+					return !sToken.empty() && *pEnd == '\0';
+				}
+
+				bool target(Entry& entry)
+				{
+					const std::string sKind = this->next();
+
+					if (sKind == "mouse")
+					{
+						entry.target = Entry::MouseButton;
+
+						return this->name(szMouseButtons, "mouse button", entry.uCode);
+					}
+					else if (sKind == "scroll")
+					{
+						entry.target = Entry::MouseScroll;
+
+						return this->name(szScrolls, "scroll direction", entry.uCode);
+					}
+					else if (sKind == "key")
+					{
+						entry.target = Entry::Key;
+
+						return this->name(szKeys, "key", entry.uCode);
+					}
+					else if (sKind == "event")
+					{
+						entry.target = Entry::Event;
+
+						return this->name(szEvents, "event", entry.uCode);
+					}
+					else if (sKind == "call")
+					{
+						const std::string sName = this->next();
+
+						const int iCall = findCall(sName);
+
+						if (iCall < 0)
+						{
+							return this->fail("unknown function '" + sName + "'");
+						}
+
+						entry.target = Entry::Call;
+						entry.uCode = static_cast<std::uint32_t>(iCall);
+
+						return true;
+					}
+
+					return this->fail("unknown target '" + sKind + "'");
+				}
+
+				bool motion(Entry& entry)
+				{
+					if (this->next() != "motion")
+					{
+						return this->fail("axes and sticks only drive motion");
+					}
+
+					entry.target = Entry::MouseMotion;
+
+					if (!this->name(szMotions, "motion", entry.uCode) || !this->number(entry.dFirst))
+					{
+						return false;
+					}
+
+					entry.dSecond = 0.25;
+
+					return true;
+				}
+
+				// Optional settings after a binding, each a keyword with its numbers.
+				bool options(Entry& entry, const bool bStick)
+				{
+					while (!this->isEmpty())
+					{
+						const std::string sOption = this->next();
+
+						if (sOption == "threshold" && entry.type != Entry::AxisButton)
+						{
+							if (!this->number(entry.dSecond))
+							{
+								return false;
+							}
+						}
+						else if ((sOption == "press" || sOption == "release") && entry.type == Entry::AxisButton)
+						{
+							if (!this->number(sOption == "press" ? entry.dFirst : entry.dSecond))
+							{
+								return false;
+							}
+						}
+						else if (sOption == "inertia" && entry.type != Entry::AxisButton)
+						{
+							if (!this->number(entry.inertia.dFriction) || (this->isNumber() && !this->number(entry.inertia.dStop)))
+							{
+								return false;
+							}
+						}
+						else if (sOption == "curve" && bStick)
+						{
+							const std::string sShape = this->next();
+
+							if (sShape == "power")
+							{
+								entry.shape = Entry::Power;
+							}
+							else if (sShape == "exponential")
+							{
+								entry.shape = Entry::Exponential;
+							}
+							else
+							{
+								return this->fail("unknown curve '" + sShape + "'");
+							}
+
+							if (!this->number(entry.dShape))
+							{
+								return false;
+							}
+						}
+						else if (sOption == "smoothing" && bStick)
+						{
+							if (!this->number(entry.smoothing.dMinimumCutoff) || !this->number(entry.smoothing.dBeta) || (this->isNumber() && !this->number(entry.smoothing.dDerivativeCutoff)))
+							{
+								return false;
+							}
+						}
+						else
+						{
+							return this->fail("unexpected '" + sOption + "'");
+						}
+					}
+
+					return true;
+				}
+			};
+
+			// FNV-1a over whole words, entries are a multiple of 8 bytes.
+			std::uint64_t checksum(const Entry* pEntries, const std::size_t szCount)
+			{
+				static_assert(sizeof(Entry) % sizeof(std::uint64_t) == 0);
+
+				std::uint64_t ullHash = 14695981039346656037ull;
+
+				const char* pData = reinterpret_cast<const char*>(pEntries);
+
+				for (std::size_t i = 0; i < szCount * sizeof(Entry); i += sizeof(std::uint64_t))
+				{
+					std::uint64_t ullWord = 0;
+
+					std::memcpy(&ullWord, pData + i, sizeof(ullWord));
+
+					ullHash = (ullHash ^ ullWord) * 1099511628211ull;
+				}
+
+				return ullHash;
+			}
+
+			// Read-only view of a whole file, empty when it cannot be read. Small files are copied instead of mapped,
+			// setting up and tearing down a mapping costs more than reading a few pages.
+			class Mapping
+			{
+			private:
+				static constexpr std::size_t szMapped = 64 * 1024;
+
+				void* pMapping = nullptr;
+
+				std::vector<std::uint64_t> vBuffer;
+
+				std::size_t szSize = 0;
+
+			public:
+				Mapping(const std::string& sPath)
+				{
+#ifdef _WIN32
+					const HANDLE hFile = CreateFileA(sPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+					if (hFile == INVALID_HANDLE_VALUE)
+					{
+						return;
+					}
+
+					LARGE_INTEGER liSize = {};
+
+					const std::size_t szSize = GetFileSizeEx(hFile, &liSize) ? static_cast<std::size_t>(liSize.QuadPart) : 0;
+
+					if (szSize >= sizeof(Header) && szSize < szMapped)
+					{
+						this->vBuffer.resize((szSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+						DWORD dwRead = 0;
+
+						if (ReadFile(hFile, this->vBuffer.data(), static_cast<DWORD>(szSize), &dwRead, NULL) && dwRead == szSize)
+						{
+							this->szSize = szSize;
+						}
+						else
+						{
+							this->vBuffer.clear();
+						}
+					}
+					else if (szSize >= sizeof(Header))
+					{
+						if (const HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL))
+						{
+							this->pMapping = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+							this->szSize = szSize;
+
+							CloseHandle(hMapping);
+						}
+					}
+
+					CloseHandle(hFile);
+#else
+					const int iDescriptor = open(sPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+					if (iDescriptor < 0)
+					{
+						return;
+					}
+
+					struct stat fileStat = {};
+
+					const std::size_t szSize = fstat(iDescriptor, &fileStat) == 0 ? static_cast<std::size_t>(fileStat.st_size) : 0;
+
+					if (szSize >= sizeof(Header) && szSize < szMapped)
+					{
+						this->vBuffer.resize((szSize + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+						std::size_t szRead = 0;
+
+						while (szRead < szSize)
+						{
+							const ssize_t iRead = ::read(iDescriptor, reinterpret_cast<char*>(this->vBuffer.data()) + szRead, szSize - szRead);
+
+							if (iRead <= 0)
+							{
+								break;
+							}
+
+							szRead += static_cast<std::size_t>(iRead);
+						}
+
+						if (szRead == szSize)
+						{
+							this->szSize = szSize;
+						}
+						else
+						{
+							this->vBuffer.clear();
+						}
+					}
+					else if (szSize >= sizeof(Header))
+					{
+						void* pMapping = mmap(nullptr, szSize, PROT_READ, MAP_PRIVATE, iDescriptor, 0);
+
+						if (pMapping != MAP_FAILED)
+						{
+							this->pMapping = pMapping;
+							this->szSize = szSize;
+						}
+					}
+
+					close(iDescriptor);
+#endif
+				}
+
+				~Mapping()
+				{
+					if (!this->pMapping)
+					{
+						return;
+					}
+
+#ifdef _WIN32
+					UnmapViewOfFile(this->pMapping);
+#else
+					munmap(this->pMapping, this->szSize);
+#endif
+				}
+
+				Mapping(const Mapping&) = delete;
+				Mapping& operator=(const Mapping&) = delete;
+
+				const void* data() const
+				{
+					return this->pMapping ? this->pMapping : this->vBuffer.data();
+				}
+
+				std::size_t size() const
+				{
+					return this->pMapping || !this->vBuffer.empty() ? this->szSize : 0;
+				}
+			};
+
+			bool parseLine(Line& line, std::vector<Entry>& vEntries)
+			{
+				Entry entry;
+
+				entry.uLine = line.line();
+
+				std::string sType = line.next();
+
+				if (sType == "always")
+				{
+					entry.bAlways = true;
+
+					sType = line.next();
+				}
+
+				std::uint32_t uSource = 0;
+
+				if (sType == "button")
+				{
+					entry.type = Entry::Button;
+
+					if (!line.name(szButtons, "button", uSource) || !line.target(entry))
+					{
+						return false;
+					}
+				}
+				else if (sType == "axis")
+				{
+					entry.type = Entry::Axis;
+
+					if (!line.name(szAxes, "axis", uSource) || !line.motion(entry) || !line.options(entry, false))
+					{
+						return false;
+					}
+				}
+				else if (sType == "axisbutton")
+				{
+					entry.type = Entry::AxisButton;
+
+					entry.dFirst = 0.5;
+					entry.dSecond = 0.25;
+
+					if (!line.name(szAxes, "axis", uSource) || !line.target(entry) || !line.options(entry, false))
+					{
+						return false;
+					}
+				}
+				else if (sType == "stick")
+				{
+					entry.type = Entry::Stick;
+
+					if (!line.name(szSticks, "stick", uSource) || !line.motion(entry) || !line.options(entry, true))
+					{
+						return false;
+					}
+				}
+				else if (sType == "combination")
+				{
+					std::size_t szParts = 0;
+
+					for (bool bPart = true; bPart;)
+					{
+						Entry part;
+
+						part.type = Entry::Part;
+						part.uLine = entry.uLine;
+						part.bAlways = entry.bAlways;
+
+						const int iButton = find(szButtons, line.peek());
+						const int iAxis = find(szAxes, line.peek());
+
+						bPart = iButton >= 0 || iAxis >= 0;
+
+						if (bPart)
+						{
+							line.next();
+
+							part.uSource = static_cast<std::uint8_t>(iButton >= 0 ? iButton : iAxis);
+							part.bAxis = iButton < 0;
+
+							part.dFirst = 0.5;
+							part.dSecond = 0.25;
+
+							vEntries.push_back(part);
+
+							szParts++;
+						}
+					}
+
+					if (szParts == 0)
+					{
+						return line.fail("a combination needs buttons or axes");
+					}
+
+					entry.type = Entry::Combination;
+
+					if (!line.target(entry))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					return line.fail("unknown binding '" + sType + "'");
+				}
+
+				if (!line.isEmpty())
+				{
+					return line.fail("unexpected '" + line.peek() + "'");
+				}
+
+				entry.uSource = static_cast<std::uint8_t>(uSource);
+
+				vEntries.push_back(entry);
+
+				return true;
+			}
+		}
+
+		Profile::Profile(const std::span<const Entry> entries) :
+			szEntries(entries.size()), layout(0, true, nullptr)
+		{
+			Gamepad& layout = this->layout;
+
+			const auto fAction = [&layout](const Entry& entry) -> Action {
+				switch (entry.target)
+				{
+				case Entry::MouseButton:
+				{
+					return layout.makeAction(static_cast<mouse::Button::Name>(entry.uCode));
+				}
+				case Entry::MouseScroll:
+				{
+					return layout.makeAction(static_cast<mouse::Scroll::Name>(entry.uCode));
+				}
+				case Entry::MouseMotion:
+				{
+					return layout.makeAction(static_cast<mouse::Motion::Name>(entry.uCode));
+				}
+				case Entry::Key:
+				{
+					return layout.makeAction(static_cast<key::Key::Name>(entry.uCode));
+				}
+				case Entry::Event:
+				{
+					return layout.makeAction(static_cast<Gamepad::Event::Name>(entry.uCode));
+				}
+				case Entry::Call:
+				{
+					return entry.uCode < std::size(calls) ? layout.makeAction(calls[entry.uCode].fFunction, none) : Action();
+				}
+				default:
+				{
+					return {};
+				}
+				}
+			};
+
+			struct Binding
+			{
+				std::uint32_t uSlot = 0;
+				std::uint32_t uEntry = 0;
+
+				bool bAlways = false;
+
+				Action action;
+			};
+
+			std::vector<Binding> vBindings;
+
+			vBindings.reserve(entries.size());
+
+			// Actions and combinations are made in the order of the entries, the parts of a combination precede it and take its action.
+			for (std::size_t i = 0, szParts = 0; i < entries.size(); i++)
+			{
+				const Entry& entry = entries[i];
+
+				if (entry.type == Entry::Part)
+				{
+					szParts++;
+
+					continue;
+				}
+
+				if (entry.type == Entry::Combination)
+				{
+					const std::size_t szCombination = layout.vCombinations.size();
+
+					layout.vCombinations.push_back(Gamepad::Combination());
+
+					layout.vCombinations[szCombination].action = fAction(entry);
+					layout.vCombinations[szCombination].szCount = szParts;
+
+					const Action combination = { Action::Combination, static_cast<std::uint32_t>(szCombination), 0 };
+
+					for (std::size_t szPart = i - szParts; szPart < i; szPart++)
+					{
+						const std::uint32_t uTable = entries[szPart].bAxis ? Entry::Axis : Entry::Button;
+
+						vBindings.push_back({ (uTable << 9) | (static_cast<std::uint32_t>(!entry.bAlways) << 8) | entries[szPart].uSource, static_cast<std::uint32_t>(szPart), static_cast<bool>(entry.bAlways), combination });
+					}
+
+					szParts = 0;
+
+					continue;
+				}
+
+				if (entry.type < Entry::Part)
+				{
+					const std::uint32_t uTable = entry.type == Entry::AxisButton ? Entry::Axis : entry.type;
+
+					vBindings.push_back({ (uTable << 9) | (static_cast<std::uint32_t>(!entry.bAlways) << 8) | entry.uSource, static_cast<std::uint32_t>(i), static_cast<bool>(entry.bAlways), fAction(entry) });
+				}
+			}
+
+			// Bound slot by slot every binding lands at the end of its table instead of shifting all later slots.
+			std::stable_sort(vBindings.begin(), vBindings.end(), [](const Binding& first, const Binding& second) {
+				return first.uSlot < second.uSlot;
+			});
+
+			std::vector<std::pair<const Entry*, CurvePtr>> vCurves;
+
+			for (const Binding& binding : vBindings)
+			{
+				const Entry& entry = entries[binding.uEntry];
+
+				switch (entry.type)
+				{
+				case Entry::Button:
+				{
+					layout.bindButton(binding.bAlways, static_cast<gp::Button::Name>(entry.uSource), binding.action);
+
+					break;
+				}
+				case Entry::Axis:
+				{
+					layout.bindAxis(binding.bAlways, static_cast<gp::Axis::Name>(entry.uSource), binding.action, true, entry.dFirst, entry.dSecond, entry.inertia);
+
+					break;
+				}
+				case Entry::AxisButton:
+				{
+					layout.bindAxis(binding.bAlways, static_cast<gp::Axis::Name>(entry.uSource), binding.action, false, entry.dFirst, entry.dSecond);
+
+					break;
+				}
+				case Entry::Stick:
+				{
+					CurvePtr pCurve;
+
+					// Sampling a curve is the most expensive part of a binding, sticks with the same shape share one.
+					if (entry.shape == Entry::Power || entry.shape == Entry::Exponential)
+					{
+						const auto iterator = std::find_if(vCurves.begin(), vCurves.end(), [&entry](const std::pair<const Entry*, CurvePtr>& curve) {
+							return curve.first->shape == entry.shape && curve.first->dShape == entry.dShape;
+						});
+
+						if (iterator != vCurves.end())
+						{
+							pCurve = iterator->second;
+						}
+						else
+						{
+							pCurve = entry.shape == Entry::Power ? makePowerCurve(entry.dShape) : makeExponentialCurve(entry.dShape);
+
+							vCurves.emplace_back(&entry, pCurve);
+						}
+					}
+
+					layout.bindStick(binding.bAlways, static_cast<gp::Stick::Name>(entry.uSource), binding.action, entry.dFirst, entry.dSecond, pCurve, entry.smoothing, entry.inertia);
+
+					break;
+				}
+				case Entry::Part:
+				{
+					if (entry.bAxis)
+					{
+						layout.bindAxis(binding.bAlways, static_cast<gp::Axis::Name>(entry.uSource), binding.action, false, entry.dFirst, entry.dSecond);
+					}
+					else
+					{
+						layout.bindButton(binding.bAlways, static_cast<gp::Button::Name>(entry.uSource), binding.action);
+					}
+
+					break;
+				}
+				default:
+				{
+					break;
+				}
+				}
+			}
+		}
+
+		std::size_t Profile::size() const
+		{
+			return this->szEntries;
+		}
+
+		const Gamepad& Profile::bindings() const
+		{
+			return this->layout;
+		}
+
+		bool parse(const std::string& sText, std::vector<Entry>& vEntries, std::string& sError)
+		{
+			std::istringstream stream(sText);
+
+			std::uint32_t uLine = 0;
+
+			for (std::string sLine; std::getline(stream, sLine);)
+			{
+				Line line(sLine, ++uLine, sError);
+
+				if (!line.isEmpty() && !parseLine(line, vEntries))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		ProfilePtr compile(const std::string& sText, std::string& sError)
+		{
+			std::vector<Entry> vEntries;
+
+			if (!parse(sText, vEntries, sError))
+			{
+				return nullptr;
+			}
+
+			return std::make_shared<const Profile>(std::span<const Entry>(vEntries));
+		}
+
+		ProfilePtr map(const std::string& sPath, const std::uint64_t ullSize, const std::int64_t llWritten)
+		{
+			const Mapping mapping(sPath);
+
+			if (mapping.size() < sizeof(Header))
+			{
+				return nullptr;
+			}
+
+			const Header header;
+			const Header* pHeader = static_cast<const Header*>(mapping.data());
+
+			if (std::memcmp(pHeader->cMagic, header.cMagic, sizeof(header.cMagic)) != 0 || pHeader->uVersion != header.uVersion || pHeader->uEntrySize != header.uEntrySize || pHeader->uKeys != header.uKeys)
+			{
+				return nullptr;
+			}
+
+			if (mapping.size() != sizeof(Header) + static_cast<std::size_t>(pHeader->uCount) * sizeof(Entry) || pHeader->ullSize != ullSize || pHeader->llWritten != llWritten)
+			{
+				return nullptr;
+			}
+
+			const Entry* pEntries = reinterpret_cast<const Entry*>(static_cast<const char*>(mapping.data()) + sizeof(Header));
+
+			if (pHeader->ullChecksum != checksum(pEntries, pHeader->uCount))
+			{
+				return nullptr;
+			}
+
+			return std::make_shared<const Profile>(std::span<const Entry>(pEntries, pHeader->uCount));
+		}
+
+		bool store(const std::string& sPath, const std::uint64_t ullSize, const std::int64_t llWritten, const std::vector<Entry>& vEntries)
+		{
+			Header header;
+
+			header.uCount = static_cast<std::uint32_t>(vEntries.size());
+			header.ullSize = ullSize;
+			header.llWritten = llWritten;
+			header.ullChecksum = checksum(vEntries.data(), vEntries.size());
+
+			// Written next to the cache and renamed over it, so a reader maps either the old or the new one.
+			const std::string sTemporary = sPath + ".tmp";
+
+			{
+				std::ofstream file(sTemporary, std::ios::binary | std::ios::trunc);
+
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(vEntries.data()), static_cast<std::streamsize>(vEntries.size() * sizeof(Entry)));
+
+				if (!file.flush())
+				{
+					return false;
+				}
+			}
+
+			std::error_code error;
+
+			std::filesystem::rename(sTemporary, sPath, error);
+
+			if (error)
+			{
+				std::filesystem::remove(sTemporary, error);
+
+				return false;
+			}
+
+			return true;
+		}
+
+		ProfilePtr load(const std::string& sPath, std::string& sError, bool* pCached)
+		{
+			std::error_code error;
+
+			// Taken before the text is read, a file written in between leaves a cache that no longer matches it.
+			const std::uintmax_t umSize = std::filesystem::file_size(sPath, error);
+
+			const std::filesystem::file_time_type tWritten = error ? std::filesystem::file_time_type() : std::filesystem::last_write_time(sPath, error);
+
+			if (error)
+			{
+				sError = "cannot open " + sPath;
+
+				return nullptr;
+			}
+
+			const std::string sCache = sPath + ".cache";
+
+			ProfilePtr pProfile = map(sCache, umSize, tWritten.time_since_epoch().count());
+
+			if (pCached)
+			{
+				*pCached = pProfile != nullptr;
+			}
+
+			if (pProfile)
+			{
+				return pProfile;
+			}
+
+			std::ifstream file(sPath, std::ios::binary);
+
+			if (!file)
+			{
+				sError = "cannot open " + sPath;
+
+				return nullptr;
+			}
+
+			const std::string sText((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+			std::vector<Entry> vEntries;
+
+			if (!parse(sText, vEntries, sError))
+			{
+				return nullptr;
+			}
+
+			store(sCache, umSize, tWritten.time_since_epoch().count(), vEntries);
+
+			return std::make_shared<const Profile>(std::span<const Entry>(vEntries));
+		}
+
+		Watcher::Watcher(const std::string& sPath, const std::chrono::milliseconds msInterval) :
+			sPath(sPath), msInterval(msInterval)
+		{
+			this->reload();
+
+			this->thread = std::thread(&Watcher::run, this);
+		}
+
+		Watcher::~Watcher()
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->lock);
+
+				this->bRun = false;
+			}
+
+			this->wake.notify_one();
+
+			if (this->thread.joinable())
+			{
+				this->thread.join();
+			}
+		}
+
+		void Watcher::reload()
+		{
+			const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+			std::string sError;
+
+			bool bCached = false;
+
+			ProfilePtr pProfile = profile::load(this->sPath, sError, &bCached);
+
+			if (!pProfile)
+			{
+				this->ullErrors.fetch_add(1, std::memory_order_relaxed);
+
+				std::lock_guard<std::mutex> lock(this->lock);
+
+				this->sError = sError;
+
+				return;
+			}
+
+			this->loadHistogram.record(std::chrono::steady_clock::now() - tStart);
+
+			this->ullLoads.fetch_add(1, std::memory_order_relaxed);
+
+			if (bCached)
+			{
+				this->ullCached.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			this->vProfiles.push_back(std::move(pProfile));
+
+			this->pCurrent.store(this->vProfiles.back().get());
+
+			// Everything older than the new profile can go unless the updating thread still holds it.
+			const Profile* pHazard = this->pHazard.load();
+
+			std::erase_if(this->vProfiles, [&](const ProfilePtr& pOld) {
+				return pOld.get() != this->vProfiles.back().get() && pOld.get() != pHazard;
+			});
+
+			std::lock_guard<std::mutex> lock(this->lock);
+
+			this->sError.clear();
+		}
+
+		void Watcher::run()
+		{
+			std::error_code error;
+
+			std::filesystem::file_time_type tWritten = std::filesystem::last_write_time(this->sPath, error);
+
+			std::uintmax_t umSize = std::filesystem::file_size(this->sPath, error);
+
+			std::unique_lock<std::mutex> lock(this->lock);
+
+			while (!this->wake.wait_for(lock, this->msInterval, [this] { return !this->bRun; }))
+			{
+				lock.unlock();
+
+				const std::filesystem::file_time_type tNow = std::filesystem::last_write_time(this->sPath, error);
+
+				const std::uintmax_t umNow = error ? 0 : std::filesystem::file_size(this->sPath, error);
+
+				if (!error && (tNow != tWritten || umNow != umSize))
+				{
+					tWritten = tNow;
+					umSize = umNow;
+
+					this->reload();
+				}
+
+				lock.lock();
+			}
+		}
+
+		const Profile* Watcher::acquire()
+		{
+			const Profile* pProfile = nullptr;
+
+			const Profile* pCurrent = this->pCurrent.load();
+
+			// Publishing the hazard and reading the current profile again closes the window in which the watcher could free it.
+			while (pProfile != pCurrent)
+			{
+				pProfile = pCurrent;
+
+				this->pHazard.store(pProfile);
+
+				pCurrent = this->pCurrent.load();
+			}
+
+			return pProfile;
+		}
+
+		const stats::Histogram& Watcher::load() const
+		{
+			return this->loadHistogram;
+		}
+
+		std::string Watcher::error()
+		{
+			std::lock_guard<std::mutex> lock(this->lock);
+
+			return this->sError;
+		}
+
+		Watcher::Statistics Watcher::statistics() const
+		{
+			Statistics statistics;
+
+			statistics.ullLoads = this->ullLoads.load(std::memory_order_relaxed);
+			statistics.ullErrors = this->ullErrors.load(std::memory_order_relaxed);
+			statistics.ullCached = this->ullCached.load(std::memory_order_relaxed);
+
+			return statistics;
+		}
+
+		WatcherPtr makeWatcher(const std::string& sPath, const std::chrono::milliseconds msInterval)
+		{
+			return std::make_shared<Watcher>(sPath, msInterval);
+		}
+	}
+}
@@ -0,0 +1,235 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "gamepad.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gp
+{
+	namespace profile
+	{
+		// One line of a profile after parsing, plain data so a compiled profile can be stored and applied without the text.
+		// Combinations are a run of Part entries followed by the Combination entry that carries the target.
+		struct Entry
+		{
+			typedef enum : std::uint8_t
+			{
+				Button,
+				Axis,
+				AxisButton,
+				Stick,
+				Part,
+				Combination,
+				Count
+			} Type;
+
+			typedef enum : std::uint8_t
+			{
+				None,
+				MouseButton,
+				MouseScroll,
+				MouseMotion,
+				Key,
+				Event,
+				Call,
+				Targets
+			} Target;
+
+			typedef enum : std::uint8_t
+			{
+				Linear,
+				Power,
+				Exponential,
+				Curves
+			} Shape;
+
+			Type type = Button;
+			Target target = None;
+			Shape shape = Linear;
+
+			std::uint8_t bAlways = false;
+
+			// Button, axis or stick the entry reads, parts of a combination set bAxis when they read an axis.
+			std::uint8_t uSource = 0;
+			std::uint8_t bAxis = false;
+
+			std::uint16_t wReserved = 0;
+
+			std::uint32_t uCode = 0;
+
+			std::uint32_t uLine = 0;
+
+			// Speed and threshold of motion bindings, press and release thresholds of axis buttons and parts.
+			double dFirst = 0.0;
+			double dSecond = 0.0;
+
+			double dShape = 0.0;
+
+			Smoothing smoothing;
+
+			mouse::Inertia inertia;
+		};
+
+		static_assert(std::is_trivially_copyable_v<Entry> && sizeof(Entry) == 80);
+
+		// A cache is a Header followed by the entries of one profile, it stands for the file whose size and write time it carries.
+		// Name tables that grow shift the codes, so the number of keys is part of the version.
+		struct Header
+		{
+			char cMagic[8] = { 'G', 'P', 'P', 'R', 'O', 'F', 'I', 'L' };
+
+			std::uint32_t uVersion = 2;
+			std::uint32_t uEntrySize = sizeof(Entry);
+			std::uint32_t uKeys = key::Key::Count;
+			std::uint32_t uCount = 0;
+
+			std::uint64_t ullSize = 0;
+			std::int64_t llWritten = 0;
+
+			std::uint64_t ullChecksum = 0;
+		};
+
+		static_assert(sizeof(Header) == 48);
+
+		// Bindings compiled from a profile into the tables of a pad without backend, Gamepad::adopt() copies them into live pads.
+		class Profile
+		{
+		private:
+			std::size_t szEntries = 0;
+
+			Gamepad layout;
+
+		public:
+			Profile(const std::span<const Entry> entries);
+
+			Profile(const Profile&) = delete;
+			Profile(Profile&&) = delete;
+
+			Profile& operator=(const Profile&) = delete;
+			Profile& operator=(Profile&&) = delete;
+
+			// Number of entries the profile was built from.
+			std::size_t size() const;
+
+			const Gamepad& bindings() const;
+		};
+
+		typedef std::shared_ptr<const Profile> ProfilePtr;
+
+		// Parses a profile into entries, returns false and describes the first error in sError.
+		extern bool parse(const std::string& sText, std::vector<Entry>& vEntries, std::string& sError);
+
+		extern ProfilePtr compile(const std::string& sText, std::string& sError);
+
+		// Maps the cache at sPath and builds the profile straight from its entries, nullptr when it is missing, belongs to another version of the file or fails the checksum.
+		extern ProfilePtr map(const std::string& sPath, const std::uint64_t ullSize, const std::int64_t llWritten);
+
+		extern bool store(const std::string& sPath, const std::uint64_t ullSize, const std::int64_t llWritten, const std::vector<Entry>& vEntries);
+
+		// Uses the cache next to the file (sPath + ".cache") while it matches the size and write time of the file, the text is only read to compile and rewrite it otherwise.
+		extern ProfilePtr load(const std::string& sPath, std::string& sError, bool* pCached = nullptr);
+
+		// Reloads a profile file from its own thread whenever it changes and publishes every version that compiles.
+		// The thread that updates the pads takes the latest one with acquire(), which never waits: the profile it took last
+		// is guarded by a hazard pointer and all others are freed by the watcher once a newer one is published.
+		class Watcher
+		{
+		public:
+			struct Statistics
+			{
+				unsigned long long ullLoads = 0;
+				unsigned long long ullErrors = 0;
+				unsigned long long ullCached = 0;
+			};
+
+		private:
+			std::string sPath;
+
+			std::vector<ProfilePtr> vProfiles;
+
+			std::atomic<const Profile*> pCurrent = nullptr;
+			std::atomic<const Profile*> pHazard = nullptr;
+
+			std::chrono::milliseconds msInterval;
+
+			std::mutex lock;
+			std::condition_variable wake;
+
+			bool bRun = true;
+
+			std::string sError;
+
+			stats::Histogram loadHistogram;
+
+			std::atomic<unsigned long long> ullLoads = 0;
+			std::atomic<unsigned long long> ullErrors = 0;
+			std::atomic<unsigned long long> ullCached = 0;
+
+			std::thread thread;
+
+			void reload();
+
+			void run();
+
+		public:
+			Watcher(const std::string& sPath, const std::chrono::milliseconds msInterval);
+
+			~Watcher();
+
+			Watcher(const Watcher&) = delete;
+			Watcher(Watcher&&) = delete;
+
+			Watcher& operator=(const Watcher&) = delete;
+			Watcher& operator=(Watcher&&) = delete;
+
+			// Latest profile or nullptr while none compiled, stays valid until the next call from the same thread.
+			const Profile* acquire();
+
+			// Time to read and compile the file, recorded by the watcher thread.
+			const stats::Histogram& load() const;
+
+			std::string error();
+
+			Statistics statistics() const;
+		};
+
+		typedef std::shared_ptr<Watcher> WatcherPtr;
+
+		// Compiles the file once before returning, so pads attached right after already get it.
+		extern WatcherPtr makeWatcher(const std::string& sPath, const std::chrono::milliseconds msInterval = std::chrono::milliseconds(250));
+	}
+}
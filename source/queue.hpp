@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace gp
+{
+	// Bounded single-producer/single-consumer ring, push() only from one thread and pop() only from another.
+	template <typename T, const std::size_t szCapacity>
+	class Queue
+	{
+	private:
+		T items[szCapacity] = {};
+
+		alignas(64) std::atomic<std::size_t> szHead = 0;
+		alignas(64) std::atomic<std::size_t> szTail = 0;
+
+	public:
+		bool push(const T& item)
+		{
+			const std::size_t szHead = this->szHead.load(std::memory_order_relaxed);
+
+			if (szHead - this->szTail.load(std::memory_order_acquire) >= szCapacity)
+			{
+				return false;
+			}
+
+			this->items[szHead % szCapacity] = item;
+
+			this->szHead.store(szHead + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool pop(T& item)
+		{
+			const std::size_t szTail = this->szTail.load(std::memory_order_relaxed);
+
+			if (szTail == this->szHead.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			item = this->items[szTail % szCapacity];
+
+			this->szTail.store(szTail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		std::size_t size() const
+		{
+			return this->szHead.load(std::memory_order_acquire) - this->szTail.load(std::memory_order_acquire);
+		}
+	};
+
+	// Bounded multi-producer/single-consumer ring, every cell carries a sequence number that tells producers and the consumer whose turn it is.
+	template <typename T, const std::size_t szCapacity>
+	class MpscQueue
+	{
+	private:
+		static_assert((szCapacity & (szCapacity - 1)) == 0, "capacity must be a power of two");
+
+		struct Cell
+		{
+			std::atomic<std::size_t> szSequence = 0;
+
+			T item = {};
+		};
+
+		Cell cells[szCapacity];
+
+		alignas(64) std::atomic<std::size_t> szHead = 0;
+		alignas(64) std::size_t szTail = 0;
+
+	public:
+		MpscQueue()
+		{
+			for (std::size_t i = 0; i < szCapacity; i++)
+			{
+				this->cells[i].szSequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		bool push(const T& item)
+		{
+			std::size_t szPosition = this->szHead.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				Cell& cell = this->cells[szPosition & (szCapacity - 1)];
+
+				const std::size_t szSequence = cell.szSequence.load(std::memory_order_acquire);
+
+				if (szSequence == szPosition)
+				{
+					if (this->szHead.compare_exchange_weak(szPosition, szPosition + 1, std::memory_order_relaxed))
+					{
+						cell.item = item;
+
+						cell.szSequence.store(szPosition + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (szSequence < szPosition)
+				{
+					return false;
+				}
+				else
+				{
+					szPosition = this->szHead.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool pop(T& item)
+		{
+			Cell& cell = this->cells[this->szTail & (szCapacity - 1)];
+
+			if (cell.szSequence.load(std::memory_order_acquire) != this->szTail + 1)
+			{
+				return false;
+			}
+
+			item = cell.item;
+
+			cell.szSequence.store(this->szTail + szCapacity, std::memory_order_release);
+
+			this->szTail++;
+
+			return true;
+		}
+
+		// Consumer side only.
+		std::size_t size() const
+		{
+			return this->szHead.load(std::memory_order_relaxed) - this->szTail;
+		}
+	};
+}
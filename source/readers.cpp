@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "readers.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gp
+{
+	Readers::Readers(const BackendPtr& pBackend, const std::chrono::microseconds usInterval) :
+		pBackend(pBackend), usInterval(usInterval), vReaders(static_cast<std::size_t>(std::max(pBackend->count(), 0)))
+	{
+		const int iCount = this->pBackend->count();
+
+		this->vCurrent.resize(static_cast<std::size_t>(iCount));
+		this->vConsumed.resize(static_cast<std::size_t>(iCount));
+
+		this->vBatch.reserve(1024);
+
+		// Hotplug backends report their devices through changes(), which starts their readers.
+		if (!this->pBackend->isHotplug())
+		{
+			this->prober = std::thread(&Readers::probe, this);
+		}
+	}
+
+	Readers::~Readers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->threads);
+
+			this->bRun = false;
+		}
+
+		this->attached.notify_all();
+
+		if (this->prober.joinable())
+		{
+			this->prober.join();
+		}
+
+		for (Reader& reader : this->vReaders)
+		{
+			if (reader.thread.joinable())
+			{
+				reader.thread.join();
+			}
+		}
+	}
+
+	bool Readers::readBackend(const int iIndex, State& state)
+	{
+		if (this->pBackend->isConcurrent())
+		{
+			return this->pBackend->read(iIndex, state);
+		}
+
+		std::lock_guard<std::mutex> lock(this->reads);
+
+		return this->pBackend->read(iIndex, state);
+	}
+
+	void Readers::attach(const int iIndex)
+	{
+		if (iIndex < 0 || iIndex >= this->count())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->threads);
+
+			Reader& reader = this->vReaders[iIndex];
+
+			reader.bAttached = true;
+			reader.uGeneration++;
+
+			if (!reader.thread.joinable())
+			{
+				reader.thread = std::thread(&Readers::run, this, iIndex);
+			}
+		}
+
+		this->attached.notify_all();
+	}
+
+	void Readers::run(const int iIndex)
+	{
+		// Polling backends have nothing to block on, event driven ones only wake to notice shutdown.
+		const std::chrono::microseconds usWait = this->pBackend->isEventDriven() ? std::chrono::microseconds(250000) : this->usInterval;
+
+		Reader& reader = this->vReaders[iIndex];
+
+		Delta last;
+
+		last.wIndex = static_cast<std::uint16_t>(iIndex);
+
+		unsigned int uGeneration = 0;
+
+		while (this->bRun.load(std::memory_order_relaxed))
+		{
+			{
+				std::unique_lock<std::mutex> lock(this->threads);
+
+				this->attached.wait(lock, [&reader, this] { return !this->bRun || reader.bAttached; });
+
+				uGeneration = reader.uGeneration;
+			}
+
+			State state;
+
+			// An empty slot is never read, so the backend does not go looking for devices on this thread.
+			const bool bConnected = this->pBackend->waitInput(iIndex, usWait) && this->readBackend(iIndex, state);
+
+			if (!bConnected)
+			{
+				state = State();
+
+				std::lock_guard<std::mutex> lock(this->threads);
+
+				// A device attached meanwhile keeps the reader going.
+				if (reader.uGeneration == uGeneration)
+				{
+					reader.bAttached = false;
+				}
+			}
+
+			if (last.wConnected != bConnected || std::memcmp(&last.state, &state, sizeof(State)) != 0)
+			{
+				Delta delta = last;
+
+				delta.ullTime = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(this->pBackend->now().time_since_epoch()).count());
+				delta.wConnected = bConnected;
+				delta.state = state;
+
+				// A dropped delta leaves the last state untouched, so the change is pushed again on the next read.
+				if (this->deltas.push(delta))
+				{
+					last = delta;
+
+					this->ullDeltas.fetch_add(1, std::memory_order_relaxed);
+
+					Backend::wake();
+				}
+				else
+				{
+					this->ullDrops.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+
+	void Readers::probe()
+	{
+		std::unique_lock<std::mutex> lock(this->threads);
+
+		do
+		{
+			for (int iIndex = 0; iIndex < this->count() && this->bRun; iIndex++)
+			{
+				if (this->vReaders[iIndex].bAttached)
+				{
+					continue;
+				}
+
+				lock.unlock();
+
+				State state;
+
+				if (this->readBackend(iIndex, state))
+				{
+					this->attach(iIndex);
+				}
+
+				lock.lock();
+			}
+		}
+		while (!this->attached.wait_for(lock, std::chrono::seconds(1), [this] { return !this->bRun; }));
+	}
+
+	int Readers::count() const
+	{
+		return static_cast<int>(this->vCurrent.size());
+	}
+
+	bool Readers::read(const int iIndex, State& state)
+	{
+		if (iIndex < 0 || iIndex >= this->count())
+		{
+			return false;
+		}
+
+		const Delta& current = this->vCurrent[iIndex];
+
+		this->vConsumed[iIndex] = current.state;
+
+		state = current.state;
+
+		return current.wConnected;
+	}
+
+	bool Readers::isEventDriven() const
+	{
+		return true;
+	}
+
+	bool Readers::isHotplug() const
+	{
+		return this->pBackend->isHotplug();
+	}
+
+	std::size_t Readers::changes(Change* pChanges, const std::size_t szCount)
+	{
+		std::size_t szChanges = 0;
+
+		if (this->pBackend->isConcurrent())
+		{
+			szChanges = this->pBackend->changes(pChanges, szCount);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(this->reads);
+
+			szChanges = this->pBackend->changes(pChanges, szCount);
+		}
+
+		// Readers of detached slots find the slot empty themselves and park.
+		for (std::size_t i = 0; i < szChanges; i++)
+		{
+			if (pChanges[i].type == Change::Attached)
+			{
+				this->attach(pChanges[i].iIndex);
+			}
+		}
+
+		return szChanges;
+	}
+
+	std::chrono::steady_clock::time_point Readers::now() const
+	{
+		return this->pBackend->now();
+	}
+
+	void Readers::dispatch(const std::function<void(const int iIndex)>& fFlush)
+	{
+		const std::size_t szDepth = this->deltas.size();
+
+		this->szDepth.store(szDepth, std::memory_order_relaxed);
+
+		if (szDepth > this->szDepthMax.load(std::memory_order_relaxed))
+		{
+			this->szDepthMax.store(szDepth, std::memory_order_relaxed);
+		}
+
+		this->vBatch.clear();
+
+		Delta delta;
+
+		while (this->vBatch.size() < this->vBatch.capacity() && this->deltas.pop(delta))
+		{
+			this->vBatch.push_back(delta);
+		}
+
+		// Producers stamp before they push, so deltas of different pads may arrive slightly out of order.
+		std::stable_sort(this->vBatch.begin(), this->vBatch.end(), [](const Delta& first, const Delta& second) { return first.ullTime < second.ullTime; });
+
+		for (const Delta& next : this->vBatch)
+		{
+			Delta& current = this->vCurrent[next.wIndex];
+
+			const bool bUnread = current.state.wButtons != this->vConsumed[next.wIndex].wButtons;
+
+			if (bUnread && next.state.wButtons != current.state.wButtons)
+			{
+				fFlush(next.wIndex);
+			}
+
+			current = next;
+		}
+	}
+
+	Readers::Statistics Readers::statistics() const
+	{
+		Statistics statistics;
+
+		statistics.ullDeltas = this->ullDeltas.load(std::memory_order_relaxed);
+		statistics.ullDrops = this->ullDrops.load(std::memory_order_relaxed);
+		statistics.szDepth = this->szDepth.load(std::memory_order_relaxed);
+		statistics.szDepthMax = this->szDepthMax.load(std::memory_order_relaxed);
+
+		return statistics;
+	}
+
+	ReadersPtr makeReaders(const BackendPtr& pBackend, const std::chrono::microseconds usInterval)
+	{
+		if (!pBackend)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<Readers>(pBackend, usInterval);
+	}
+}
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "backend.hpp"
+#include "queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gp
+{
+	// Reads every attached pad of a backend on its own thread, so a stalled device only delays itself. Readers of event
+	// driven backends block until their device reports, the others read every usInterval. Changes travel as timestamped deltas through one ring and are applied in time order by the thread that updates the pads.
+	class Readers : public Backend
+	{
+	public:
+		struct Delta
+		{
+			std::uint64_t ullTime = 0;
+
+			std::uint16_t wIndex = 0;
+			std::uint16_t wConnected = 0;
+
+			State state;
+		};
+
+		struct Statistics
+		{
+			unsigned long long ullDeltas = 0;
+			unsigned long long ullDrops = 0;
+
+			std::size_t szDepth = 0;
+			std::size_t szDepthMax = 0;
+		};
+
+	private:
+		BackendPtr pBackend;
+
+		std::chrono::microseconds usInterval;
+
+		// Serializes reads of backends that are not safe to read from several threads.
+		std::mutex reads;
+
+		MpscQueue<Delta, 1024> deltas;
+
+		std::vector<Delta> vBatch;
+		std::vector<Delta> vCurrent;
+		std::vector<State> vConsumed;
+
+		std::atomic<bool> bRun = true;
+
+		// Created when a device first attaches to the slot and parked while the slot is empty, so empty slots cost nothing.
+		struct Reader
+		{
+			std::thread thread;
+
+			bool bAttached = false;
+
+			unsigned int uGeneration = 0;
+		};
+
+		std::mutex threads;
+		std::condition_variable attached;
+
+		std::vector<Reader> vReaders;
+
+		// Without hotplug a single thread looks for pads in empty slots once a second.
+		std::thread prober;
+
+		std::atomic<unsigned long long> ullDeltas = 0;
+		std::atomic<unsigned long long> ullDrops = 0;
+		std::atomic<std::size_t> szDepth = 0;
+		std::atomic<std::size_t> szDepthMax = 0;
+
+		bool readBackend(const int iIndex, State& state);
+
+		void attach(const int iIndex);
+
+		void run(const int iIndex);
+
+		void probe();
+
+	public:
+		Readers(const BackendPtr& pBackend, const std::chrono::microseconds usInterval);
+
+		~Readers();
+
+		Readers(const Readers&) = delete;
+		Readers(Readers&&) = delete;
+
+		Readers& operator=(const Readers&) = delete;
+		Readers& operator=(Readers&&) = delete;
+
+		int count() const override;
+
+		// Returns the state applied last by dispatch().
+		bool read(const int iIndex, State& state) override;
+
+		bool isEventDriven() const override;
+
+		bool isHotplug() const override;
+
+		std::size_t changes(Change* pChanges, const std::size_t szCount) override;
+
+		std::chrono::steady_clock::time_point now() const override;
+
+		// Applies all queued deltas in time order, fFlush(iIndex) runs whenever a delta would overwrite a button change the pad has not read yet.
+		void dispatch(const std::function<void(const int iIndex)>& fFlush);
+
+		Statistics statistics() const;
+	};
+
+	typedef std::shared_ptr<Readers> ReadersPtr;
+
+	extern ReadersPtr makeReaders(const BackendPtr& pBackend, const std::chrono::microseconds usInterval = std::chrono::microseconds(1000));
+}
@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "scheduler.hpp"
+
+#include <algorithm>
+
+namespace gp
+{
+	Scheduler::Scheduler(const std::vector<int>& vRates, const std::chrono::milliseconds quietPeriod) :
+		vRates(vRates), vTimes(vRates.size()), quietPeriod(quietPeriod), tLast(std::chrono::steady_clock::now()), tActive(tLast)
+	{
+		if (this->vRates.empty())
+		{
+			this->vRates.push_back(100);
+			this->vTimes.resize(1);
+		}
+
+		std::sort(this->vRates.begin(), this->vRates.end(), std::greater<int>());
+	}
+
+	void Scheduler::update(const bool bActive)
+	{
+		const std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+		this->vTimes[this->szRate] += tNow - this->tLast;
+
+		this->tLast = tNow;
+
+		if (bActive)
+		{
+			this->szRate = 0;
+			this->tActive = tNow;
+		}
+		else if (this->szRate + 1 < this->vRates.size() && tNow - this->tActive >= this->quietPeriod)
+		{
+			this->szRate++;
+			this->tActive = tNow;
+		}
+	}
+
+	void Scheduler::setQuietPeriod(const std::chrono::milliseconds quietPeriod)
+	{
+		this->quietPeriod = quietPeriod;
+	}
+
+	int Scheduler::rate() const
+	{
+		return this->vRates[this->szRate];
+	}
+
+	int Scheduler::interval() const
+	{
+		return std::max(1, 1000 / std::max(1, this->rate()));
+	}
+
+	const std::vector<int>& Scheduler::rates() const
+	{
+		return this->vRates;
+	}
+
+	double Scheduler::time(const std::size_t szIndex) const
+	{
+		if (szIndex >= this->vTimes.size())
+		{
+			return 0.0;
+		}
+
+		return std::chrono::duration<double>(this->vTimes[szIndex]).count();
+	}
+}
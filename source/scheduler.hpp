@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <chrono>
+
+namespace gp
+{
+	class Scheduler
+	{
+	private:
+		std::vector<int> vRates;
+		std::vector<std::chrono::steady_clock::duration> vTimes;
+
+		std::size_t szRate = 0;
+
+		std::chrono::steady_clock::duration quietPeriod;
+
+		std::chrono::steady_clock::time_point tLast;
+		std::chrono::steady_clock::time_point tActive;
+
+	public:
+		Scheduler(const std::vector<int>& vRates = { 1000, 500, 250, 125, 60, 30 }, const std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(250));
+
+		void update(const bool bActive);
+
+		void setQuietPeriod(const std::chrono::milliseconds quietPeriod);
+
+		int rate() const;
+
+		int interval() const;
+
+		const std::vector<int>& rates() const;
+
+		double time(const std::size_t szIndex) const;
+	};
+}
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace stats
+{
+	std::size_t Histogram::index(const std::uint64_t ullValue)
+	{
+		if (ullValue < Linear)
+		{
+			return static_cast<std::size_t>(ullValue);
+		}
+
+		const std::size_t szMagnitude = static_cast<std::size_t>(std::bit_width(ullValue)) - 6;
+
+		if (szMagnitude > Magnitudes)
+		{
+			return Buckets - 1;
+		}
+
+		return Linear + (szMagnitude - 1) * Steps + static_cast<std::size_t>((ullValue >> szMagnitude) - Steps);
+	}
+
+	std::uint64_t Histogram::value(const std::size_t szIndex)
+	{
+		if (szIndex < Linear)
+		{
+			return szIndex;
+		}
+
+		const std::size_t szMagnitude = (szIndex - Linear) / Steps + 1;
+
+		// Upper edge of the bucket, so percentiles never under-report.
+		return ((((szIndex - Linear) % Steps + Steps) + 1) << szMagnitude) - 1;
+	}
+
+	void Histogram::record(const std::chrono::nanoseconds nsValue)
+	{
+		const std::uint64_t ullValue = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(nsValue.count(), 0));
+
+		std::atomic<std::uint64_t>& ullBucket = this->ullBuckets[index(ullValue)];
+
+		ullBucket.store(ullBucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		this->ullCount.store(this->ullCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		if (ullValue > this->ullMax.load(std::memory_order_relaxed))
+		{
+			this->ullMax.store(ullValue, std::memory_order_relaxed);
+		}
+	}
+
+	std::uint64_t Histogram::count() const
+	{
+		return this->ullCount.load(std::memory_order_relaxed);
+	}
+
+	std::chrono::nanoseconds Histogram::percentile(const double dPercentile) const
+	{
+		std::uint64_t ullTotal = 0;
+
+		for (const std::atomic<std::uint64_t>& ullBucket : this->ullBuckets)
+		{
+			ullTotal += ullBucket.load(std::memory_order_relaxed);
+		}
+
+		if (ullTotal == 0)
+		{
+			return std::chrono::nanoseconds::zero();
+		}
+
+		const std::uint64_t ullTarget = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(dPercentile / 100.0 * static_cast<double>(ullTotal))), 1);
+
+		std::uint64_t ullSeen = 0;
+
+		for (std::size_t i = 0; i < Buckets; i++)
+		{
+			ullSeen += this->ullBuckets[i].load(std::memory_order_relaxed);
+
+			if (ullSeen >= ullTarget)
+			{
+				return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(std::min(value(i), this->ullMax.load(std::memory_order_relaxed))));
+			}
+		}
+
+		return this->max();
+	}
+
+	std::chrono::nanoseconds Histogram::max() const
+	{
+		return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(this->ullMax.load(std::memory_order_relaxed)));
+	}
+}
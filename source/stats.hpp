@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace stats
+{
+	// Log-linear buckets with 32 steps per power of two (about 3% resolution) up to two minutes.
+	// One thread records with plain relaxed stores, any other thread may read at any time without locking.
+	class Histogram
+	{
+	public:
+		static constexpr std::size_t Linear = 64;
+		static constexpr std::size_t Steps = 32;
+		static constexpr std::size_t Magnitudes = 32;
+		static constexpr std::size_t Buckets = Linear + Magnitudes * Steps;
+
+	private:
+		std::atomic<std::uint64_t> ullBuckets[Buckets] = {};
+
+		std::atomic<std::uint64_t> ullCount = 0;
+		std::atomic<std::uint64_t> ullMax = 0;
+
+		static std::size_t index(const std::uint64_t ullValue);
+
+		static std::uint64_t value(const std::size_t szIndex);
+
+	public:
+		void record(const std::chrono::nanoseconds nsValue);
+
+		std::uint64_t count() const;
+
+		std::chrono::nanoseconds percentile(const double dPercentile) const;
+
+		std::chrono::nanoseconds max() const;
+	};
+}
@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "switcher.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace gp
+{
+	namespace profile
+	{
+		namespace
+		{
+			std::string normalize(std::string sApplication)
+			{
+				std::transform(sApplication.begin(), sApplication.end(), sApplication.begin(), [](const unsigned char cCharacter) { return static_cast<char>(std::tolower(cCharacter)); });
+
+				if (sApplication.size() > 4 && sApplication.compare(sApplication.size() - 4, 4, ".exe") == 0)
+				{
+					sApplication.resize(sApplication.size() - 4);
+				}
+
+				return sApplication;
+			}
+		}
+
+		Switcher::Switcher(const FocusPtr& pFocus, const WatcherPtr& pDefault, const std::vector<Rule>& vRules, const std::chrono::milliseconds msInterval) :
+			pFocus(pFocus), vWatchers(1, pDefault), msInterval(msInterval)
+		{
+			for (const Rule& rule : vRules)
+			{
+				this->vApplications.push_back(normalize(rule.sApplication));
+
+				this->vWatchers.push_back(makeWatcher(rule.sPath));
+			}
+
+			this->follow();
+
+			this->thread = std::thread(&Switcher::run, this);
+		}
+
+		Switcher::~Switcher()
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->lock);
+
+				this->bRun = false;
+			}
+
+			this->wake.notify_one();
+
+			if (this->thread.joinable())
+			{
+				this->thread.join();
+			}
+		}
+
+		void Switcher::follow()
+		{
+			const Focus::Window window = this->pFocus->foreground();
+
+			if (window.ullHandle == this->last.ullHandle && window.uProcess == this->last.uProcess)
+			{
+				return;
+			}
+
+			this->last = window;
+
+			std::size_t szRule = 0;
+
+			const auto iterator = this->windows.find(window.ullHandle);
+
+			if (iterator != this->windows.end() && iterator->second.uProcess == window.uProcess)
+			{
+				szRule = iterator->second.szRule;
+			}
+			else
+			{
+				const std::string sApplication = normalize(this->pFocus->application(window));
+
+				const auto match = std::find(this->vApplications.begin(), this->vApplications.end(), sApplication);
+
+				szRule = match != this->vApplications.end() && !sApplication.empty() ? static_cast<std::size_t>(match - this->vApplications.begin()) + 1 : 0;
+
+				// Closed windows are never removed one by one, the whole index is rebuilt once it grows too large.
+				if (this->windows.size() >= 1024)
+				{
+					this->windows.clear();
+				}
+
+				this->windows[window.ullHandle] = { window.uProcess, szRule };
+
+				this->ullLookups.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (this->szActive.exchange(szRule) != szRule)
+			{
+				this->ullSwitches.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		void Switcher::run()
+		{
+			std::unique_lock<std::mutex> lock(this->lock);
+
+			while (!this->wake.wait_for(lock, this->msInterval, [this] { return !this->bRun; }))
+			{
+				lock.unlock();
+
+				this->follow();
+
+				lock.lock();
+			}
+		}
+
+		const Profile* Switcher::acquire()
+		{
+			const std::size_t szRule = this->szActive.load();
+
+			const Profile* pProfile = szRule > 0 ? this->vWatchers[szRule]->acquire() : nullptr;
+
+			if (!pProfile && this->vWatchers[0])
+			{
+				pProfile = this->vWatchers[0]->acquire();
+			}
+
+			return pProfile;
+		}
+
+		Switcher::Statistics Switcher::statistics() const
+		{
+			Statistics statistics;
+
+			statistics.ullSwitches = this->ullSwitches.load(std::memory_order_relaxed);
+			statistics.ullLookups = this->ullLookups.load(std::memory_order_relaxed);
+
+			return statistics;
+		}
+
+		std::vector<Switcher::Rule> loadRules(const std::string& sPath)
+		{
+			std::vector<Switcher::Rule> vRules;
+
+			std::ifstream file(sPath);
+
+			const std::filesystem::path directory = std::filesystem::path(sPath).parent_path();
+
+			for (std::string sLine; std::getline(file, sLine);)
+			{
+				std::istringstream line(sLine.substr(0, sLine.find('#')));
+
+				Switcher::Rule rule;
+
+				if (!(line >> rule.sApplication))
+				{
+					continue;
+				}
+
+				std::getline(line >> std::ws, rule.sPath);
+
+				rule.sPath.erase(rule.sPath.find_last_not_of(" \t\r") + 1);
+
+				if (!rule.sPath.empty())
+				{
+					rule.sPath = (directory / rule.sPath).string();
+
+					vRules.push_back(rule);
+				}
+			}
+
+			return vRules;
+		}
+
+		SwitcherPtr makeSwitcher(const FocusPtr& pFocus, const WatcherPtr& pDefault, const std::vector<Switcher::Rule>& vRules, const std::chrono::milliseconds msInterval)
+		{
+			return pFocus ? std::make_shared<Switcher>(pFocus, pDefault, vRules, msInterval) : nullptr;
+		}
+	}
+}
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "focus.hpp"
+#include "profile.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace gp
+{
+	namespace profile
+	{
+		// Follows the focus from its own thread and picks the profile of the application in the foreground.
+		// A window is matched against the rules once and the answer is kept with the id of its process, so acquire() only reads an index.
+		class Switcher
+		{
+		public:
+			struct Rule
+			{
+				std::string sApplication;
+				std::string sPath;
+			};
+
+			struct Statistics
+			{
+				unsigned long long ullSwitches = 0;
+				unsigned long long ullLookups = 0;
+			};
+
+		private:
+			FocusPtr pFocus;
+
+			std::vector<std::string> vApplications;
+
+			// The first watcher is the default profile and may be missing, the others belong to the rules in order.
+			std::vector<WatcherPtr> vWatchers;
+
+			struct Match
+			{
+				std::uint32_t uProcess = 0;
+
+				std::size_t szRule = 0;
+			};
+
+			// Ids of exited processes are reused, an answer only counts for the window and process id it was made for.
+			std::unordered_map<std::uint64_t, Match> windows;
+
+			Focus::Window last;
+
+			std::atomic<std::size_t> szActive = 0;
+
+			std::chrono::milliseconds msInterval;
+
+			std::mutex lock;
+			std::condition_variable wake;
+
+			bool bRun = true;
+
+			std::atomic<unsigned long long> ullSwitches = 0;
+			std::atomic<unsigned long long> ullLookups = 0;
+
+			std::thread thread;
+
+			void follow();
+
+			void run();
+
+		public:
+			Switcher(const FocusPtr& pFocus, const WatcherPtr& pDefault, const std::vector<Rule>& vRules, const std::chrono::milliseconds msInterval);
+
+			~Switcher();
+
+			Switcher(const Switcher&) = delete;
+			Switcher(Switcher&&) = delete;
+
+			Switcher& operator=(const Switcher&) = delete;
+			Switcher& operator=(Switcher&&) = delete;
+
+			// Profile of the focused application, the default one while its own has not compiled, nullptr for the built-in layout.
+			// Like Watcher::acquire() it never waits and only one thread may call it.
+			const Profile* acquire();
+
+			Statistics statistics() const;
+		};
+
+		typedef std::shared_ptr<Switcher> SwitcherPtr;
+
+		// One rule per line, an application and the profile for it such as "game.exe game.profile", # starts a comment.
+		// Relative profile paths start at the directory of the rules file, a missing file has no rules.
+		extern std::vector<Switcher::Rule> loadRules(const std::string& sPath);
+
+		// Rules name an executable without directory, matched without case and with or without .exe.
+		extern SwitcherPtr makeSwitcher(const FocusPtr& pFocus, const WatcherPtr& pDefault, const std::vector<Switcher::Rule>& vRules, const std::chrono::milliseconds msInterval = std::chrono::milliseconds(100));
+	}
+}
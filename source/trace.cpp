@@ -0,0 +1,364 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace gp
+{
+	namespace trace
+	{
+		Replay::Replay(const std::string& sPath)
+		{
+#ifdef _WIN32
+			const HANDLE hFile = CreateFileA(sPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+			if (hFile == INVALID_HANDLE_VALUE)
+			{
+				return;
+			}
+
+			LARGE_INTEGER liSize = {};
+
+			if (GetFileSizeEx(hFile, &liSize) && liSize.QuadPart >= static_cast<LONGLONG>(sizeof(Header)))
+			{
+				if (const HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL))
+				{
+					this->pMapping = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+					this->szSize = static_cast<std::size_t>(liSize.QuadPart);
+
+					CloseHandle(hMapping);
+				}
+			}
+
+			CloseHandle(hFile);
+#else
+			const int iDescriptor = open(sPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+			if (iDescriptor < 0)
+			{
+				return;
+			}
+
+			struct stat fileStat = {};
+
+			if (fstat(iDescriptor, &fileStat) == 0 && fileStat.st_size >= static_cast<off_t>(sizeof(Header)))
+			{
+				void* pMapping = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, iDescriptor, 0);
+
+				if (pMapping != MAP_FAILED)
+				{
+					this->pMapping = pMapping;
+					this->szSize = static_cast<std::size_t>(fileStat.st_size);
+				}
+			}
+
+			close(iDescriptor);
+#endif
+
+			if (!this->pMapping)
+			{
+				return;
+			}
+
+			const Header header;
+			const Header* pHeader = static_cast<const Header*>(this->pMapping);
+
+			if (std::memcmp(pHeader->cMagic, header.cMagic, sizeof(header.cMagic)) != 0 || pHeader->uVersion != header.uVersion || pHeader->uRecordSize != header.uRecordSize)
+			{
+				return;
+			}
+
+			this->pRecords = reinterpret_cast<const Record*>(static_cast<const char*>(this->pMapping) + sizeof(Header));
+			this->szRecords = (this->szSize - sizeof(Header)) / sizeof(Record);
+
+			for (std::size_t i = 0; i < this->szRecords; i++)
+			{
+				this->iCount = std::max(this->iCount, this->pRecords[i].wIndex + 1);
+			}
+
+			this->vCurrent.resize(static_cast<std::size_t>(this->iCount));
+		}
+
+		Replay::~Replay()
+		{
+			if (!this->pMapping)
+			{
+				return;
+			}
+
+#ifdef _WIN32
+			UnmapViewOfFile(this->pMapping);
+#else
+			munmap(this->pMapping, this->szSize);
+#endif
+		}
+
+		bool Replay::isValid() const
+		{
+			return this->pRecords != nullptr;
+		}
+
+		int Replay::count() const
+		{
+			return this->iCount;
+		}
+
+		bool Replay::read(const int iIndex, State& state)
+		{
+			if (iIndex < 0 || iIndex >= this->iCount || !this->vCurrent[iIndex].wConnected)
+			{
+				return false;
+			}
+
+			state = this->vCurrent[iIndex].state;
+
+			return true;
+		}
+
+		bool Replay::wait(const int)
+		{
+			return true;
+		}
+
+		std::chrono::steady_clock::time_point Replay::now() const
+		{
+			return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(this->nsTime));
+		}
+
+		std::chrono::nanoseconds Replay::time() const
+		{
+			return this->nsTime;
+		}
+
+		std::chrono::nanoseconds Replay::duration() const
+		{
+			return std::chrono::nanoseconds(this->szRecords ? this->pRecords[this->szRecords - 1].ullTime : 0);
+		}
+
+		bool Replay::advance(const std::chrono::nanoseconds nsStep)
+		{
+			const bool bRemaining = this->szPosition < this->szRecords;
+
+			this->nsTime += nsStep;
+
+			while (this->szPosition < this->szRecords && this->pRecords[this->szPosition].ullTime <= static_cast<std::uint64_t>(this->nsTime.count()))
+			{
+				const Record& record = this->pRecords[this->szPosition++];
+
+				this->vCurrent[record.wIndex] = record;
+			}
+
+			return bRemaining;
+		}
+
+		ReplayPtr makeReplay(const std::string& sPath)
+		{
+			ReplayPtr pReplay = std::make_shared<Replay>(sPath);
+
+			return pReplay->isValid() ? pReplay : nullptr;
+		}
+
+		class Recorder : public Backend
+		{
+		private:
+			BackendPtr pBackend;
+
+			std::ofstream file;
+
+			std::chrono::steady_clock::time_point tStart;
+
+			std::vector<Record> vLast;
+
+			Record records[4096];
+
+			std::atomic<std::size_t> szHead = 0;
+			std::atomic<std::size_t> szTail = 0;
+
+			std::atomic<bool> bRun = true;
+
+			std::thread thread;
+
+			void drain()
+			{
+				const std::size_t szHead = this->szHead.load(std::memory_order_acquire);
+
+				std::size_t szTail = this->szTail.load(std::memory_order_relaxed);
+
+				while (szTail != szHead)
+				{
+					const std::size_t szBegin = szTail % std::size(this->records);
+					const std::size_t szEnd = std::min(szBegin + (szHead - szTail), std::size(this->records));
+
+					this->file.write(reinterpret_cast<const char*>(this->records + szBegin), static_cast<std::streamsize>((szEnd - szBegin) * sizeof(Record)));
+
+					szTail += szEnd - szBegin;
+				}
+
+				this->szTail.store(szTail, std::memory_order_release);
+
+				this->file.flush();
+			}
+
+			void run()
+			{
+				while (this->bRun.load(std::memory_order_relaxed))
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+					this->drain();
+				}
+
+				this->drain();
+			}
+
+		public:
+			Recorder(const BackendPtr& pBackend, const std::string& sPath) :
+				pBackend(pBackend), file(sPath, std::ios::binary | std::ios::trunc), tStart(pBackend->now())
+			{
+				const Header header;
+
+				this->file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+				this->thread = std::thread(&Recorder::run, this);
+			}
+
+			~Recorder()
+			{
+				this->bRun = false;
+
+				this->thread.join();
+			}
+
+			int count() const override
+			{
+				return this->pBackend->count();
+			}
+
+			bool read(const int iIndex, State& state) override
+			{
+				const bool bConnected = this->pBackend->read(iIndex, state);
+
+				if (iIndex < 0)
+				{
+					return bConnected;
+				}
+
+				if (static_cast<std::size_t>(iIndex) >= this->vLast.size())
+				{
+					this->vLast.resize(static_cast<std::size_t>(iIndex) + 1);
+				}
+
+				Record& last = this->vLast[iIndex];
+
+				if (last.wConnected == bConnected && (!bConnected || std::memcmp(&last.state, &state, sizeof(State)) == 0))
+				{
+					return bConnected;
+				}
+
+				const std::size_t szHead = this->szHead.load(std::memory_order_relaxed);
+
+				// A full ring drops the record without updating the last state, so the change is written once there is room again.
+				if (szHead - this->szTail.load(std::memory_order_acquire) >= std::size(this->records))
+				{
+					return bConnected;
+				}
+
+				Record& record = this->records[szHead % std::size(this->records)];
+
+				record.ullTime = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(this->pBackend->now() - this->tStart).count());
+				record.wIndex = static_cast<std::uint16_t>(iIndex);
+				record.wConnected = bConnected;
+				record.state = bConnected ? state : State();
+
+				last = record;
+
+				this->szHead.store(szHead + 1, std::memory_order_release);
+
+				return bConnected;
+			}
+
+			bool isEventDriven() const override
+			{
+				return this->pBackend->isEventDriven();
+			}
+
+			bool wait(const int iTimeout) override
+			{
+				return this->pBackend->wait(iTimeout);
+			}
+
+			void wake() override
+			{
+				this->pBackend->wake();
+			}
+
+			bool waitInput(const int iIndex, const std::chrono::microseconds usTimeout) override
+			{
+				return this->pBackend->waitInput(iIndex, usTimeout);
+			}
+
+			bool isHotplug() const override
+			{
+				return this->pBackend->isHotplug();
+			}
+
+			std::size_t changes(Change* pChanges, const std::size_t szCount) override
+			{
+				return this->pBackend->changes(pChanges, szCount);
+			}
+
+			std::chrono::steady_clock::time_point now() const override
+			{
+				return this->pBackend->now();
+			}
+		};
+
+		BackendPtr makeRecorder(const BackendPtr& pBackend, const std::string& sPath)
+		{
+			if (!pBackend)
+			{
+				return nullptr;
+			}
+
+			return std::make_shared<Recorder>(pBackend, sPath);
+		}
+	}
+}
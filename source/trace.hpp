@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "backend.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gp
+{
+	namespace trace
+	{
+		// A trace is a Header followed by Records sorted by time, a pad only gets a record when its raw state or connection changes.
+		struct Header
+		{
+			char cMagic[8] = { 'G', 'P', 'T', 'R', 'A', 'C', 'E', '\0' };
+
+			std::uint32_t uVersion = 1;
+			std::uint32_t uRecordSize = 24;
+		};
+
+		struct Record
+		{
+			std::uint64_t ullTime = 0;
+
+			std::uint16_t wIndex = 0;
+			std::uint16_t wConnected = 0;
+
+			State state;
+		};
+
+		static_assert(sizeof(Header) == 16 && sizeof(Record) == 24);
+
+		// Feeds a memory-mapped trace to the pads, time only moves on advance() so every run over the same trace is identical.
+		class Replay : public Backend
+		{
+		private:
+			void* pMapping = nullptr;
+
+			std::size_t szSize = 0;
+
+			const Record* pRecords = nullptr;
+
+			std::size_t szRecords = 0;
+			std::size_t szPosition = 0;
+
+			int iCount = 0;
+
+			std::vector<Record> vCurrent;
+
+			std::chrono::nanoseconds nsTime = std::chrono::nanoseconds::zero();
+
+		public:
+			Replay(const std::string& sPath);
+
+			~Replay();
+
+			Replay(const Replay&) = delete;
+			Replay(Replay&&) = delete;
+
+			Replay& operator=(const Replay&) = delete;
+			Replay& operator=(Replay&&) = delete;
+
+			bool isValid() const;
+
+			int count() const override;
+
+			bool read(const int iIndex, State& state) override;
+
+			bool wait(const int iTimeout) override;
+
+			std::chrono::steady_clock::time_point now() const override;
+
+			std::chrono::nanoseconds time() const;
+
+			std::chrono::nanoseconds duration() const;
+
+			// Moves virtual time forward and applies every record up to it, returns false once the trace is exhausted.
+			bool advance(const std::chrono::nanoseconds nsStep);
+		};
+
+		typedef std::shared_ptr<Replay> ReplayPtr;
+
+		extern ReplayPtr makeReplay(const std::string& sPath);
+
+		// Wraps a backend and hands its reads to a background writer, the poll thread never touches the file.
+		extern BackendPtr makeRecorder(const BackendPtr& pBackend, const std::string& sPath);
+	}
+}
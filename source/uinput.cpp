@@ -0,0 +1,459 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "output.hpp"
+
+#ifdef __linux__
+
+#include "mouse.hpp"
+#include "keyboard.hpp"
+
+#include <vector>
+#include <iterator>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+
+// High resolution wheel codes arrived with Linux 5.0, they count 1/120 notch like the wheel events of Windows.
+#ifndef REL_WHEEL_HI_RES
+#define REL_WHEEL_HI_RES 0x0b
+#endif
+
+#ifndef REL_HWHEEL_HI_RES
+#define REL_HWHEEL_HI_RES 0x0c
+#endif
+
+namespace output
+{
+	const unsigned short usKeyMap[] =
+	{
+		BTN_LEFT,
+		BTN_RIGHT,
+		KEY_CANCEL,
+		BTN_MIDDLE,
+		BTN_SIDE,
+		BTN_EXTRA,
+		KEY_BACKSPACE,
+		KEY_TAB,
+		KEY_CLEAR,
+		KEY_ENTER,
+		KEY_LEFTSHIFT,
+		KEY_LEFTCTRL,
+		KEY_LEFTALT,
+		KEY_PAUSE,
+		KEY_CAPSLOCK,
+		KEY_KATAKANAHIRAGANA,
+		KEY_HANGEUL,
+		KEY_HANGEUL,
+		0,
+		0,
+		0,
+		KEY_HANJA,
+		KEY_ZENKAKUHANKAKU,
+		0,
+		KEY_ESC,
+		KEY_HENKAN,
+		KEY_MUHENKAN,
+		0,
+		0,
+		KEY_SPACE,
+		KEY_PAGEUP,
+		KEY_PAGEDOWN,
+		KEY_END,
+		KEY_HOME,
+		KEY_LEFT,
+		KEY_UP,
+		KEY_RIGHT,
+		KEY_DOWN,
+		KEY_SELECT,
+		KEY_PRINT,
+		0,
+		KEY_SYSRQ,
+		KEY_INSERT,
+		KEY_DELETE,
+		KEY_HELP,
+		KEY_0,
+		KEY_1,
+		KEY_2,
+		KEY_3,
+		KEY_4,
+		KEY_5,
+		KEY_6,
+		KEY_7,
+		KEY_8,
+		KEY_9,
+		KEY_A,
+		KEY_B,
+		KEY_C,
+		KEY_D,
+		KEY_E,
+		KEY_F,
+		KEY_G,
+		KEY_H,
+		KEY_I,
+		KEY_J,
+		KEY_K,
+		KEY_L,
+		KEY_M,
+		KEY_N,
+		KEY_O,
+		KEY_P,
+		KEY_Q,
+		KEY_R,
+		KEY_S,
+		KEY_T,
+		KEY_U,
+		KEY_V,
+		KEY_W,
+		KEY_X,
+		KEY_Y,
+		KEY_Z,
+		KEY_LEFTMETA,
+		KEY_RIGHTMETA,
+		KEY_COMPOSE,
+		KEY_SLEEP,
+		KEY_KP0,
+		KEY_KP1,
+		KEY_KP2,
+		KEY_KP3,
+		KEY_KP4,
+		KEY_KP5,
+		KEY_KP6,
+		KEY_KP7,
+		KEY_KP8,
+		KEY_KP9,
+		KEY_KPASTERISK,
+		KEY_KPPLUS,
+		KEY_KPCOMMA,
+		KEY_KPMINUS,
+		KEY_KPDOT,
+		KEY_KPSLASH,
+		KEY_F1,
+		KEY_F2,
+		KEY_F3,
+		KEY_F4,
+		KEY_F5,
+		KEY_F6,
+		KEY_F7,
+		KEY_F8,
+		KEY_F9,
+		KEY_F10,
+		KEY_F11,
+		KEY_F12,
+		KEY_F13,
+		KEY_F14,
+		KEY_F15,
+		KEY_F16,
+		KEY_F17,
+		KEY_F18,
+		KEY_F19,
+		KEY_F20,
+		KEY_F21,
+		KEY_F22,
+		KEY_F23,
+		KEY_F24,
+		KEY_NUMLOCK,
+		KEY_SCROLLLOCK,
+		KEY_LEFTSHIFT,
+		KEY_RIGHTSHIFT,
+		KEY_LEFTCTRL,
+		KEY_RIGHTCTRL,
+		KEY_LEFTALT,
+		KEY_RIGHTALT,
+		KEY_BACK,
+		KEY_FORWARD,
+		KEY_REFRESH,
+		KEY_STOP,
+		KEY_SEARCH,
+		KEY_BOOKMARKS,
+		KEY_HOMEPAGE,
+		KEY_MUTE,
+		KEY_VOLUMEDOWN,
+		KEY_VOLUMEUP,
+		KEY_NEXTSONG,
+		KEY_PREVIOUSSONG,
+		KEY_STOPCD,
+		KEY_PLAYPAUSE,
+		KEY_MAIL,
+		KEY_MEDIA,
+		KEY_PROG1,
+		KEY_PROG2,
+		KEY_SEMICOLON,
+		KEY_EQUAL,
+		KEY_COMMA,
+		KEY_MINUS,
+		KEY_DOT,
+		KEY_SLASH,
+		KEY_GRAVE,
+		KEY_LEFTBRACE,
+		KEY_BACKSLASH,
+		KEY_RIGHTBRACE,
+		KEY_APOSTROPHE,
+		0,
+		KEY_102ND,
+		0,
+		0,
+		0,
+		0,
+		0,
+		0,
+		KEY_PLAY,
+		KEY_ZOOM,
+		0,
+		0,
+		0
+	};
+
+	static_assert(std::size(usKeyMap) == key::Key::Count);
+
+	const unsigned short usButtonMap[] =
+	{
+		BTN_LEFT,
+		BTN_MIDDLE,
+		BTN_RIGHT,
+		BTN_SIDE,
+		BTN_EXTRA
+	};
+
+	static_assert(std::size(usButtonMap) == mouse::Button::Count);
+
+	class UinputSink : public Sink
+	{
+	private:
+		int iDescriptor = -1;
+
+		std::vector<input_event> vInputs;
+
+		int iWheelRemainder = 0;
+		int iWheelHorizontalRemainder = 0;
+
+		void add(const unsigned short usType, const unsigned short usCode, const int iValue)
+		{
+			input_event input;
+
+			std::memset(&input, 0, sizeof(input));
+
+			input.type = usType;
+			input.code = usCode;
+			input.value = iValue;
+
+			this->vInputs.push_back(input);
+		}
+
+		void synchronize()
+		{
+			if (!this->vInputs.empty() && !(this->vInputs.back().type == EV_SYN && this->vInputs.back().code == SYN_REPORT))
+			{
+				this->add(EV_SYN, SYN_REPORT, 0);
+			}
+		}
+
+		int notches(int& iRemainder, const int iDelta)
+		{
+			iRemainder += iDelta;
+
+			const int iNotches = iRemainder / mouse::Scroll::Delta;
+
+			iRemainder -= iNotches * mouse::Scroll::Delta;
+
+			return iNotches;
+		}
+
+	public:
+		UinputSink() :
+			iDescriptor(open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC))
+		{
+			if (this->iDescriptor < 0)
+			{
+				return;
+			}
+
+			ioctl(this->iDescriptor, UI_SET_EVBIT, EV_KEY);
+			ioctl(this->iDescriptor, UI_SET_EVBIT, EV_REL);
+
+			for (const unsigned short usCode : usKeyMap)
+			{
+				if (usCode != 0)
+				{
+					ioctl(this->iDescriptor, UI_SET_KEYBIT, usCode);
+				}
+			}
+
+			for (const unsigned short usCode : usButtonMap)
+			{
+				ioctl(this->iDescriptor, UI_SET_KEYBIT, usCode);
+			}
+
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_X);
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_Y);
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_WHEEL);
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_HWHEEL);
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+			ioctl(this->iDescriptor, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+
+			uinput_setup setup;
+
+			std::memset(&setup, 0, sizeof(setup));
+
+			setup.id.bustype = BUS_VIRTUAL;
+			std::strncpy(setup.name, "gamepad-mouse", UINPUT_MAX_NAME_SIZE - 1);
+
+			if (ioctl(this->iDescriptor, UI_DEV_SETUP, &setup) < 0 || ioctl(this->iDescriptor, UI_DEV_CREATE) < 0)
+			{
+				::close(this->iDescriptor);
+
+				this->iDescriptor = -1;
+			}
+		}
+
+		~UinputSink()
+		{
+			if (this->iDescriptor >= 0)
+			{
+				ioctl(this->iDescriptor, UI_DEV_DESTROY);
+
+				::close(this->iDescriptor);
+			}
+		}
+
+		void commit(const Event* pEvents, const std::size_t szCount) override
+		{
+			if (this->iDescriptor < 0)
+			{
+				return;
+			}
+
+			this->vInputs.clear();
+
+			for (std::size_t i = 0; i < szCount; i++)
+			{
+				const Event& event = pEvents[i];
+
+				switch (event.type)
+				{
+				case Event::Move:
+				{
+					if (event.iX != 0)
+					{
+						this->add(EV_REL, REL_X, event.iX);
+					}
+
+					if (event.iY != 0)
+					{
+						this->add(EV_REL, REL_Y, event.iY);
+					}
+
+					break;
+				}
+				case Event::Scroll:
+				{
+					// Clients that understand high resolution scroll smoothly, the others still see whole notches in the same report.
+					if (event.iX != 0)
+					{
+						this->add(EV_REL, REL_HWHEEL_HI_RES, event.iX);
+					}
+
+					if (const int iNotches = this->notches(this->iWheelHorizontalRemainder, event.iX))
+					{
+						this->add(EV_REL, REL_HWHEEL, iNotches);
+					}
+
+					if (event.iY != 0)
+					{
+						this->add(EV_REL, REL_WHEEL_HI_RES, event.iY);
+					}
+
+					if (const int iNotches = this->notches(this->iWheelRemainder, event.iY))
+					{
+						this->add(EV_REL, REL_WHEEL, iNotches);
+					}
+
+					break;
+				}
+				case Event::ButtonPress:
+				case Event::ButtonRelease:
+				{
+					if (event.uCode < mouse::Button::Count)
+					{
+						this->synchronize();
+
+						this->add(EV_KEY, usButtonMap[event.uCode], event.type == Event::ButtonPress ? 1 : 0);
+
+						this->synchronize();
+					}
+
+					break;
+				}
+				case Event::KeyPress:
+				case Event::KeyRelease:
+				{
+					if (event.uCode < static_cast<unsigned int>(key::Key::Count) && usKeyMap[event.uCode] != 0)
+					{
+						this->synchronize();
+
+						this->add(EV_KEY, usKeyMap[event.uCode], event.type == Event::KeyPress ? 1 : 0);
+
+						this->synchronize();
+					}
+
+					break;
+				}
+				default:
+				{
+					break;
+				}
+				}
+			}
+
+			this->synchronize();
+
+			if (!this->vInputs.empty())
+			{
+				const ssize_t sWritten = write(this->iDescriptor, this->vInputs.data(), this->vInputs.size() * sizeof(input_event));
+
+				static_cast<void>(sWritten);
+			}
+		}
+	};
+
+	SinkPtr makeUinputSink()
+	{
+		return std::make_shared<UinputSink>();
+	}
+}
+
+#else
+
+namespace output
+{
+	SinkPtr makeUinputSink()
+	{
+		return nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Phil Badura
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "backend.hpp"
+
+#ifdef _WIN32
+
+#include "gamepad.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <Xinput.h>
+
+#pragma comment(lib, "XInput.lib")
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace gp
+{
+	class XInputBackend : public Backend
+	{
+	private:
+		HANDLE hTimer = NULL;
+		HANDLE hWake = NULL;
+
+	public:
+		XInputBackend() :
+			hTimer(CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS)), hWake(CreateEvent(NULL, FALSE, FALSE, NULL))
+		{
+			if (!this->hTimer)
+			{
+				this->hTimer = CreateWaitableTimer(NULL, TRUE, NULL);
+			}
+		}
+
+		~XInputBackend()
+		{
+			if (this->hTimer)
+			{
+				CloseHandle(this->hTimer);
+			}
+
+			if (this->hWake)
+			{
+				CloseHandle(this->hWake);
+			}
+		}
+
+		bool wait(const int iTimeout) override
+		{
+			if (!this->hTimer || !this->hWake)
+			{
+				return Backend::wait(iTimeout);
+			}
+
+			if (iTimeout < 0)
+			{
+				WaitForSingleObject(this->hWake, INFINITE);
+
+				return true;
+			}
+
+			LARGE_INTEGER liDueTime;
+
+			liDueTime.QuadPart = -10000LL * static_cast<LONGLONG>(iTimeout);
+
+			SetWaitableTimer(this->hTimer, &liDueTime, 0, NULL, NULL, FALSE);
+
+			const HANDLE hHandles[] = {
+				this->hTimer,
+				this->hWake
+			};
+
+			WaitForMultipleObjects(2, hHandles, FALSE, INFINITE);
+
+			return true;
+		}
+
+		void wake() override
+		{
+			if (!this->hWake)
+			{
+				return Backend::wake();
+			}
+
+			SetEvent(this->hWake);
+		}
+
+		int count() const override
+		{
+			return XUSER_MAX_COUNT;
+		}
+
+		bool isConcurrent() const override
+		{
+			return true;
+		}
+
+		bool read(const int iIndex, State& state) override
+		{
+			static const WORD wButtonMaskMap[] = {
+				XINPUT_GAMEPAD_DPAD_UP,
+				XINPUT_GAMEPAD_DPAD_DOWN,
+				XINPUT_GAMEPAD_DPAD_LEFT,
+				XINPUT_GAMEPAD_DPAD_RIGHT,
+				XINPUT_GAMEPAD_START,
+				XINPUT_GAMEPAD_BACK,
+				XINPUT_GAMEPAD_LEFT_THUMB,
+				XINPUT_GAMEPAD_RIGHT_THUMB,
+				XINPUT_GAMEPAD_LEFT_SHOULDER,
+				XINPUT_GAMEPAD_RIGHT_SHOULDER,
+				XINPUT_GAMEPAD_A,
+				XINPUT_GAMEPAD_B,
+				XINPUT_GAMEPAD_X,
+				XINPUT_GAMEPAD_Y
+			};
+
+			XINPUT_STATE xinputState;
+
+			if (XInputGetState(static_cast<DWORD>(iIndex), &xinputState) == ERROR_DEVICE_NOT_CONNECTED)
+			{
+				return false;
+			}
+
+			state.wButtons = 0;
+
+			for (unsigned int uButton = 0; uButton < Button::Count; uButton++)
+			{
+				if (xinputState.Gamepad.wButtons & wButtonMaskMap[uButton])
+				{
+					state.wButtons |= static_cast<std::uint16_t>(1u << uButton);
+				}
+			}
+
+			state.bLeftTrigger = xinputState.Gamepad.bLeftTrigger;
+			state.bRightTrigger = xinputState.Gamepad.bRightTrigger;
+
+			state.sThumbLX = xinputState.Gamepad.sThumbLX;
+			state.sThumbLY = xinputState.Gamepad.sThumbLY;
+			state.sThumbRX = xinputState.Gamepad.sThumbRX;
+			state.sThumbRY = xinputState.Gamepad.sThumbRY;
+
+			return true;
+		}
+	};
+
+	BackendPtr makeXInputBackend()
+	{
+		return std::make_shared<XInputBackend>();
+	}
+}
+
+#else
+
+namespace gp
+{
+	BackendPtr makeXInputBackend()
+	{
+		return nullptr;
+	}
+}
+
+#endif